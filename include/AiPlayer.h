@@ -6,8 +6,17 @@
 #define BOARDGAMEFRAMEWORK_AIPLAYER_H
 
 #include "BoardGame_Classes.h"
+#include "Transposition_Table.h"
+#include "Parallel_Search.h"
+#include "Search_Stats.h"
+#include "Move_Ordering.h"
 #include <map>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <limits>
+#include <memory>
+#include <thread>
 #include <vector>
 #include <type_traits>
 
@@ -27,12 +36,114 @@ using namespace std;
  * - evaluate_board() - Evaluate board position (default: simple heuristic)
  * - get_max_depth() - Maximum search depth (default: 3)
  * - generate_move_values() - Generate possible move values for position (default: single move)
+ * - play_move() / unplay_move() - Apply and undo a move during search (default: a Move<T>
+ *   on the stack carrying the value, undone with blank_symbol)
+ *
+ * The search itself does not allocate: moves live on the stack and createMove()
+ * is only called for the move returned by calculateMove().
+ *
+ * Searched positions are cached in a transposition table keyed by an incremental
+ * Zobrist hash (AI pieces are side 0, opponent pieces side 1).
+ *
+ * With set_search_threads() above 1 the root moves are split across worker
+ * threads. Each worker searches a clone of the board with its own table, and
+ * the hooks above are then called concurrently, so they must not modify the player.
+ *
+ * With set_pondering() the player keeps searching after each move: a
+ * background thread runs search_move() on a clone for every reply listed by
+ * opponent_replies(), and calculateMove() returns the stored move at once when
+ * the opponent plays one of them (otherwise the table it filled still helps).
+ *
+ * Every calculateMove() counts nodes, evaluations, cutoffs and table probes
+ * (see SearchStats); set_stats_sink() sends them on, one record per move.
+ *
+ * Each node tries the table move first, then killer and history moves, then
+ * the others by move_prior() (see MoveOrdering).
  */
 template<typename T>
 class AIPlayer : public Player<T> {
 protected:
     T blank_symbol;
     int max_depth;
+    ZobristKeys zobrist;    ///< Keys used to hash positions during search.
+    TranspositionTable tt;  ///< Cache of searched positions, kept across moves.
+    int search_threads = 1; ///< Root split workers (0 = one per hardware thread).
+    vector<unique_ptr<TranspositionTable>> helper_tt; ///< Tables of workers 1.., kept across moves.
+    bool ponder_enabled = false;     ///< Search on the opponent's time (see set_pondering()).
+    thread ponder_thread;            ///< Pondering search, if one runs.
+    atomic<bool> ponder_stop{false}; ///< Aborts the pondering search; nothing it computes is kept then.
+    map<vector<vector<T>>, unique_ptr<Move<T>>> pondered; ///< Best move of each position searched while pondering.
+    SearchStatsReporter stats;       ///< Statistics of every calculateMove().
+    SearchCounters search_counts;    ///< Counted by all threads of the last search_move().
+    int search_plies = 0;            ///< Plies searched from the root by the last search_move().
+    uint64_t ponder_nodes = 0, ponder_ns = 0; ///< Pondering since the last move.
+    uint64_t ordering_search = 0;    ///< Id of the running search, for MoveOrdering.
+    vector<int> move_priors;         ///< Prior of every move of the running search.
+
+    /** @brief Nanoseconds since begin. */
+    static uint64_t elapsed_ns(chrono::steady_clock::time_point begin) {
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - begin).count();
+    }
+
+    /**
+     * @brief Table used by a root split worker (worker 0 uses tt).
+     */
+    TranspositionTable& worker_table(int worker) {
+        if (worker == 0) return tt;
+        while ((int)helper_tt.size() < worker) helper_tt.emplace_back(new TranspositionTable());
+        return *helper_tt[worker - 1];
+    }
+
+    /**
+     * @brief Board and table of every worker of a root split search.
+     *
+     * Worker 0 searches the real board in place; the others get clones.
+     * Clones are deleted when the workers go out of scope.
+     */
+    struct SearchWorkers {
+        vector<Board<T>*> boards;
+        vector<TranspositionTable*> tables;
+        vector<unique_ptr<Board<T>>> clones;
+
+        SearchWorkers(AIPlayer<T>* player, Board<T>* board_ptr, int threads) {
+            player->start_move_ordering(board_ptr);
+            for (int w = 0; w < threads; w++) {
+                if (w == 0) {
+                    boards.push_back(board_ptr);
+                } else {
+                    clones.emplace_back(board_ptr->clone());
+                    boards.push_back(clones.back().get());
+                }
+                tables.push_back(&player->worker_table(w));
+                tables.back()->new_search();
+            }
+        }
+    };
+
+    /**
+     * @brief Static preference for a move at (x, y), the tie-break of the move ordering.
+     * @return Default: higher closer to the centre.
+     */
+    virtual int move_prior(int x, int y, int rows, int cols) const {
+        return rows + cols - abs(2 * x - (rows - 1)) - abs(2 * y - (cols - 1));
+    }
+
+    /**
+     * @brief Set up the move ordering of a new search on board_ptr (moves numbered x * columns + y).
+     */
+    virtual void start_move_ordering(Board<T>* board_ptr) {
+        int rows = board_ptr->get_rows();
+        int cols = board_ptr->get_columns();
+        move_priors.resize(rows * cols);
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < cols; j++) move_priors[i * cols + j] = move_prior(i, j, rows, cols);
+        ordering_search = MoveOrdering::new_search();
+    }
+
+    /** @brief Killers and history of the calling thread for the running search. */
+    MoveOrdering& move_ordering() {
+        return MoveOrdering::for_search(ordering_search, move_priors);
+    }
 
     /**
      * @brief Evaluate the current board position from AI's perspective.
@@ -42,11 +153,10 @@ protected:
      * @param N Sequence length to check (default: 3)
      * @return Evaluation score (positive = favorable for AI)
      */
-    virtual int evaluate_board(Board<T>* boardPtr, T ai, T opp, int N = 3) {
+    virtual int evaluate_board(Board<T>* boardPtr, T ai, T opp, int /*N*/ = 3) {
         // Default simple evaluation: check for wins/losses
-        if (boardPtr->is_win(this)) return 1000;
-        // Check if opponent would win - need to create a temporary check
-        // For default, return 0 (neutral position)
+        if (boardPtr->is_win(ai)) return 1000;
+        if (boardPtr->is_win(opp)) return -1000;
         return 0;
     }
 
@@ -58,6 +168,9 @@ protected:
         return max_depth;
     }
 
+    /// Upper bound on the values generate_move_values() may return for one cell.
+    static constexpr int MAX_MOVE_VALUES = 16;
+
     /**
      * @brief Generate possible move values for a given position.
      * 
@@ -67,15 +180,68 @@ protected:
      * @param x X coordinate
      * @param y Y coordinate
      * @param isMaximizing Whether this is the maximizing player's turn
-     * @return Vector of possible move values
+     * @param values Filled with up to MAX_MOVE_VALUES values
+     * @return Number of values written
      */
-    virtual vector<T> generate_move_values(int x, int y, bool isMaximizing) {
+    virtual int generate_move_values(int /*x*/, int /*y*/, bool isMaximizing, T values[MAX_MOVE_VALUES]) {
         // Default: single move with AI or opponent symbol
-        return vector<T>{isMaximizing ? this->get_symbol() : get_opponent_symbol()};
+        values[0] = isMaximizing ? this->get_symbol() : get_opponent_symbol();
+        return 1;
+    }
+
+    /**
+     * @brief Apply a search move to a board without allocating.
+     * @param boardPtr Board to play on
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @param value Value from generate_move_values()
+     * @return true if the board accepted the move
+     */
+    virtual bool play_move(Board<T>* boardPtr, int x, int y, T value) {
+        Move<T> move(x, y, value);
+        return boardPtr->update_board(&move);
+    }
+
+    /**
+     * @brief Undo a move applied by play_move() (blank_symbol protocol, see createUndoMove()).
+     */
+    virtual void unplay_move(Board<T>* boardPtr, int x, int y, T /*value*/) {
+        Move<T> undo(x, y, blank_symbol);
+        boardPtr->update_board(&undo);
+    }
+
+    /**
+     * @brief Compute the Zobrist key of a position from scratch.
+     * @param boardPtr Pointer to the board
+     * @param ai AI's symbol (side 0)
+     * @param opp Opponent's symbol (side 1)
+     * @param aiToMove Whether the AI is the side to move
+     * @return Position key
+     */
+    uint64_t compute_hash(Board<T>* boardPtr, T ai, T opp, bool aiToMove) {
+        int rows = boardPtr->get_rows();
+        int cols = boardPtr->get_columns();
+        zobrist.resize(rows, cols);
+        uint64_t key = aiToMove ? 0 : zobrist.side_to_move();
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < cols; j++) {
+                T cell = boardPtr->get_cell(i, j);
+                if (cell == ai) key ^= zobrist.piece(i, j, 0);
+                else if (cell == opp) key ^= zobrist.piece(i, j, 1);
+            }
+        return key;
+    }
+
+    /**
+     * @brief Key change produced by placing a piece at (x, y).
+     * @param isMaximizing Whether the AI (side 0) is the mover
+     */
+    virtual uint64_t move_hash(int x, int y, bool isMaximizing) {
+        return zobrist.piece(x, y, isMaximizing ? 0 : 1) ^ zobrist.side_to_move();
     }
 
     /**
-     * @brief Minimax algorithm with alpha-beta pruning.
+     * @brief Minimax algorithm with alpha-beta pruning and a transposition table.
      * @param boardPtr Pointer to the board
      * @param maximizingPlayer Whether it's the maximizing player's turn
      * @param ai AI's symbol
@@ -83,89 +249,252 @@ protected:
      * @param alpha Alpha value for pruning
      * @param beta Beta value for pruning
      * @param depth Current depth
+     * @param key Zobrist key of the current position
+     * @param table Transposition table of the searching thread
      * @param N Sequence length parameter
      * @return Evaluation score
      */
-    int minimax(Board<T>* boardPtr, bool maximizingPlayer, T ai, T opp, int alpha, int beta, int depth, int N = 3) {
+    int minimax(Board<T>* boardPtr, bool maximizingPlayer, T ai, T opp, int alpha, int beta, int depth,
+                uint64_t key, TranspositionTable& table, int N = 3) {
+        if (ponder_stop.load(memory_order_relaxed)) return 0; // the pondering search is thrown away
+        SearchCounters& counters = thread_search_counters();
+        counters.nodes++;
+
         // Terminal conditions
         // Check if AI (this player) wins
-        if (boardPtr->is_win(this)) return 1000 + depth; // Prefer faster wins
+        if (boardPtr->is_win(ai)) return 1000 + depth; // Prefer faster wins
         
-        // Check if opponent wins - create temporary player with opponent symbol
-        Player<T>* tempOpponent = new Player<T>("temp_opp", opp, PlayerType::AI);
-        tempOpponent->set_board_ptr(boardPtr);
-        if (boardPtr->is_win(tempOpponent)) {
-            delete tempOpponent;
-            return -1000 - depth; // Prefer slower losses
-        }
-        delete tempOpponent;
+        // Check if opponent wins - a symbol query, no Player object needed
+        if (boardPtr->is_win(opp)) return -1000 - depth; // Prefer slower losses
         
         if (boardPtr->is_draw(this)) return 0;
-        if (depth == 0) return evaluate_board(boardPtr, ai, opp, N);
+        if (depth == 0) {
+            counters.leaves++;
+            return evaluate_board(boardPtr, ai, opp, N);
+        }
 
         int rows = boardPtr->get_rows();
         int cols = boardPtr->get_columns();
 
-        if (maximizingPlayer) {
-            int best = numeric_limits<int>::min();
-            for (int i = 0; i < rows; i++) {
-                for (int j = 0; j < cols; j++) {
-                    if (condition(i, j)) {
-                        vector<T> moveValues = generate_move_values(i, j, true);
-                        for (T moveVal : moveValues) {
-                            Move<T>* move = createMove(i, j);
-                            // Update move symbol if needed (for games with value-based moves)
-                            if (move) {
-                                boardPtr->update_board(move);
-                                int val = minimax(boardPtr, false, ai, opp, alpha, beta, depth - 1, N);
-                                Move<T>* undomove = createUndoMove(i, j);
-                                if (undomove) {
-                                    boardPtr->update_board(undomove);
-                                }
-                                delete move;
-                                delete undomove;
-                                
-                                best = max(best, val);
-                                alpha = max(alpha, best);
-                                if (beta <= alpha) {
-                                    return best; // Alpha-beta pruning
-                                }
-                            }
-                        }
-                    }
+        // Transposition table: reuse the stored bound, or at least its best move
+        int alphaOrig = alpha, betaOrig = beta;
+        int ttMove = -1;
+        TTEntry entry;
+        counters.tt_probes++;
+        if (table.probe(key, entry)) {
+            counters.tt_hits++;
+            ttMove = entry.best_move;
+            if (entry.depth >= depth) {
+                int value = TableScore::from_table(entry.value, depth);
+                if (entry.flag == BoundType::EXACT) return value;
+                if (entry.flag == BoundType::LOWER) alpha = max(alpha, value);
+                else beta = min(beta, value);
+                if (beta <= alpha) return value;
+            }
+        }
+
+        int best = maximizingPlayer ? numeric_limits<int>::min() : numeric_limits<int>::max();
+        int bestMove = -1;
+        bool cutoff = false;
+        int tried = 0; // index of the move being searched, for the cutoff statistics
+        MoveOrdering& ordering = move_ordering();
+
+        auto search_cell = [&](int i, int j) {
+            T moveValues[MAX_MOVE_VALUES];
+            int n = generate_move_values(i, j, maximizingPlayer, moveValues);
+            for (int v = 0; v < n; v++) {
+                if (!play_move(boardPtr, i, j, moveValues[v])) continue;
+                int val = minimax(boardPtr, !maximizingPlayer, ai, opp, alpha, beta, depth - 1,
+                                  key ^ move_hash(i, j, maximizingPlayer), table, N);
+                unplay_move(boardPtr, i, j, moveValues[v]);
+
+                if (maximizingPlayer ? val > best : val < best) {
+                    best = val;
+                    bestMove = i * cols + j;
                 }
+                if (maximizingPlayer) alpha = max(alpha, best);
+                else beta = min(beta, best);
+                if (beta <= alpha) { // Alpha-beta pruning
+                    counters.cutoff(tried);
+                    ordering.cutoff(i * cols + j, depth);
+                    cutoff = true;
+                    return;
+                }
+                tried++;
             }
-            return best;
-        } else {
-            int best = numeric_limits<int>::max();
-            for (int i = 0; i < rows; i++) {
-                for (int j = 0; j < cols; j++) {
-                    if (condition(i, j)) {
-                        vector<T> moveValues = generate_move_values(i, j, false);
-                        for (T moveVal : moveValues) {
-                            Move<T>* move = createMove(i, j);
-                            if (move) {
-                                boardPtr->update_board(move);
-                                int val = minimax(boardPtr, true, ai, opp, alpha, beta, depth - 1, N);
-                                Move<T>* undomove = createUndoMove(i, j);
-                                if (undomove) {
-                                    boardPtr->update_board(undomove);
-                                }
-                                delete move;
-                                delete undomove;
-                                
-                                best = min(best, val);
-                                beta = min(beta, best);
-                                if (beta <= alpha) {
-                                    return best; // Alpha-beta pruning
-                                }
-                            }
-                        }
+        };
+
+        // Table move first, then killers, history and priors
+        int moves[MoveOrdering::MAX_MOVES];
+        int n = 0;
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < cols && n < MoveOrdering::MAX_MOVES; j++)
+                if (condition(boardPtr, i, j)) moves[n++] = i * cols + j;
+        ordering.order(moves, n, depth, ttMove);
+        for (int k = 0; k < n && !cutoff; k++) search_cell(moves[k] / cols, moves[k] % cols);
+
+        if (bestMove >= 0 && !ponder_stop.load(memory_order_relaxed)) {
+            BoundType flag = best <= alphaOrig ? BoundType::UPPER
+                           : best >= betaOrig ? BoundType::LOWER : BoundType::EXACT;
+            table.store(key, depth, TableScore::to_table(best, depth), flag, bestMove);
+        }
+        return best;
+    }
+
+    /**
+     * @brief Snapshot every position the opponent can reach from board_ptr (for pondering).
+     *
+     * Default: the opponent's values from generate_move_values() on every cell
+     * accepted by condition(). Boards without snapshots give no replies.
+     * @param board_ptr Board after the AI's move, left as it was
+     * @param replies Filled with one snapshot per reply
+     */
+    virtual void opponent_replies(Board<T>* board_ptr, vector<BoardSnapshot>& replies) {
+        for (int i = 0; i < board_ptr->get_rows(); i++) {
+            for (int j = 0; j < board_ptr->get_columns(); j++) {
+                if (!condition(board_ptr, i, j)) continue;
+                T moveValues[MAX_MOVE_VALUES];
+                int n = generate_move_values(i, j, false, moveValues);
+                for (int v = 0; v < n; v++) {
+                    if (!play_move(board_ptr, i, j, moveValues[v])) continue;
+                    BoardSnapshot reply;
+                    if (board_ptr->snapshot(reply)) replies.push_back(reply);
+                    unplay_move(board_ptr, i, j, moveValues[v]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Body of the pondering thread: search each reply of the opponent.
+     *
+     * Replies the last search rated best for the opponent (in the table) are
+     * searched first, as the opponent most likely plays one of them.
+     * @param board Clone of the board after the AI's move
+     */
+    void ponder(unique_ptr<Board<T>> board) {
+        T ai = this->get_symbol();
+        T opp = get_opponent_symbol();
+        if (board->is_win(ai) || board->is_win(opp) || board->is_draw(this)) return;
+
+        vector<BoardSnapshot> replies;
+        opponent_replies(board.get(), replies);
+        vector<int> scores;
+        for (auto& reply : replies) {
+            TTEntry entry;
+            board->restore(reply);
+            bool known = tt.probe(compute_hash(board.get(), ai, opp, true), entry);
+            scores.push_back(known ? entry.value : numeric_limits<int>::max());
+        }
+        vector<size_t> order(replies.size());
+        for (size_t k = 0; k < order.size(); k++) order[k] = k;
+        stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) { return scores[x] < scores[y]; });
+
+        for (size_t k : order) {
+            board->restore(replies[k]);
+            if (board->is_win(opp) || board->is_draw(this)) continue;
+            auto position = board->get_board_matrix();
+            auto begin = chrono::steady_clock::now();
+            unique_ptr<Move<T>> move(search_move(board.get()));
+            ponder_nodes += search_counts.nodes;
+            ponder_ns += elapsed_ns(begin);
+            if (ponder_stop) return;
+            pondered[position] = std::move(move);
+        }
+    }
+
+    /**
+     * @brief Search the position on board_ptr for the AI's best move.
+     *
+     * calculateMove() runs it on the player's board and pondering on a clone,
+     * so it only plays on board_ptr. Leaves its statistics in search_counts
+     * and search_plies.
+     * @return Pointer to the best move. Caller is responsible for deletion.
+     */
+    virtual Move<T>* search_move(Board<T>* board_ptr) {
+        int rows = board_ptr->get_rows();
+        int cols = board_ptr->get_columns();
+
+        int bestVal = numeric_limits<int>::min();
+        int bestX = -1, bestY = -1;
+
+        T ai = this->get_symbol();
+        T opp = get_opponent_symbol();
+
+        int maxDepth = get_max_depth();
+
+        uint64_t rootKey = compute_hash(board_ptr, ai, opp, true);
+
+        // Search the move remembered for this position first so it sets the bound early
+        int ttMove = -1;
+        TTEntry entry;
+        if (tt.probe(rootKey, entry)) ttMove = entry.best_move;
+
+        vector<pair<int, int>> roots;
+        if (ttMove >= 0 && ttMove < rows * cols && condition(board_ptr, ttMove / cols, ttMove % cols))
+            roots.push_back({ttMove / cols, ttMove % cols});
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                if (i * cols + j == ttMove) continue;
+                if (condition(board_ptr, i, j)) roots.push_back({i, j});
+            }
+        }
+
+        int threads = min(resolve_search_threads(search_threads), max(1, (int)roots.size() - 1));
+        SearchWorkers workers(this, board_ptr, threads);
+        vector<SearchCounters> counted(threads);
+        RootBest rootBest;
+
+        auto search_root = [&](int worker, int k) {
+            Board<T>* wb = workers.boards[worker];
+            auto [i, j] = roots[k];
+            T moveValues[MAX_MOVE_VALUES];
+            int n = generate_move_values(i, j, true, moveValues);
+            for (int v = 0; v < n; v++) {
+                int alpha = rootBest.alpha();
+                if (!play_move(wb, i, j, moveValues[v])) continue;
+                int eval = count_search(counted[worker], [&] {
+                    return minimax(wb, false, ai, opp,
+                                   alpha,
+                                   numeric_limits<int>::max(),
+                                   maxDepth, rootKey ^ move_hash(i, j, true), *workers.tables[worker]);
+                });
+                unplay_move(wb, i, j, moveValues[v]);
+
+                rootBest.offer(k, eval, alpha);
+            }
+        };
+
+        // The first root move sets the bound alone, the rest are split across the workers
+        if (!roots.empty()) search_root(0, 0);
+        run_root_split((int)roots.size() - 1, threads, [&](int worker, int k) { search_root(worker, k + 1); });
+
+        search_counts = SearchCounters();
+        for (auto& c : counted) search_counts.add(c);
+        search_plies = maxDepth + 1;
+
+        if (rootBest.best_index() >= 0) {
+            bestVal = rootBest.alpha();
+            bestX = roots[rootBest.best_index()].first;
+            bestY = roots[rootBest.best_index()].second;
+        }
+
+        if (bestX != -1 && !ponder_stop)
+            tt.store(rootKey, maxDepth + 1, TableScore::to_table(bestVal, maxDepth + 1), BoundType::EXACT, bestX * cols + bestY);
+
+        if (bestX == -1 || bestY == -1) {
+            // Fallback: find first valid move
+            for (int i = 0; i < rows && bestX == -1; i++) {
+                for (int j = 0; j < cols && bestX == -1; j++) {
+                    if (condition(board_ptr, i, j)) {
+                        bestX = i;
+                        bestY = j;
                     }
                 }
             }
-            return best;
         }
+
+        return createMove(bestX, bestY);
     }
 
 public:
@@ -180,7 +509,11 @@ public:
     AIPlayer(string n, T s, PlayerType t, T blank, int depth = 3) 
         : Player<T>(n, s, t), blank_symbol(blank), max_depth(depth) {}
 
-    virtual ~AIPlayer() {}
+    /**
+     * @brief Stops pondering. Runs after derived parts are gone, so a derived class
+     * whose hooks the search calls must call stop_pondering() in its own destructor.
+     */
+    virtual ~AIPlayer() { stop_pondering(); }
 
     /**
      * @brief Pure virtual function to create a valid move depending on current game rules.
@@ -204,12 +537,12 @@ public:
 
     /**
      * @brief Check if a position is valid for making a move.
+     * @param board_ptr Board to check (the player's board or a worker's clone)
      * @param x X coordinate
      * @param y Y coordinate
      * @return true if position is valid, false otherwise
      */
-    virtual bool condition(int x, int y) {
-        Board<T>* board_ptr = this->get_board_ptr();
+    virtual bool condition(Board<T>* board_ptr, int x, int y) {
         if (!board_ptr) return false;
         if (x < 0 || x >= board_ptr->get_rows() || y < 0 || y >= board_ptr->get_columns()) {
             return false;
@@ -217,6 +550,23 @@ public:
         return board_ptr->get_cell(x, y) == blank_symbol;
     }
 
+    /**
+     * @brief Check if a position is valid for making a move on the player's board.
+     */
+    bool condition(int x, int y) {
+        return condition(this->get_board_ptr(), x, y);
+    }
+
+    /**
+     * @brief Set the number of threads used to search root moves (0 = one per hardware thread).
+     */
+    void set_search_threads(int threads) { search_threads = threads; }
+
+    /**
+     * @brief Set the maximum search depth.
+     */
+    void set_max_depth(int depth) { max_depth = depth; }
+
     /**
      * @brief Get the opponent's symbol.
      * @return Opponent's symbol
@@ -231,6 +581,34 @@ public:
         return T(); // Default fallback
     }
 
+    /**
+     * @brief Send the statistics of every calculateMove() to sink (nullptr to stop), labelled with game.
+     */
+    void set_stats_sink(SearchStatsSink* sink, const string& game) { stats.attach(sink, game); }
+
+    /**
+     * @brief Statistics of the last calculateMove().
+     */
+    const SearchStats& last_search_stats() const { return stats.get_last(); }
+
+    /**
+     * @brief Search on the opponent's time after each calculateMove() (off by default).
+     */
+    void set_pondering(bool on) {
+        ponder_enabled = on;
+        if (!on) stop_pondering();
+    }
+
+    /**
+     * @brief Abort the pondering search, if any, and wait for its thread.
+     */
+    void stop_pondering() override {
+        if (!ponder_thread.joinable()) return;
+        ponder_stop = true;
+        ponder_thread.join();
+        ponder_stop = false;
+    }
+
     /**
      * @brief Calculate and return the best move using minimax algorithm.
      * @return Pointer to the best move. Caller is responsible for deletion.
@@ -239,60 +617,34 @@ public:
         Board<T>* board_ptr = this->get_board_ptr();
         if (!board_ptr) throw runtime_error("Board not assigned to player!");
 
-        int rows = board_ptr->get_rows();
-        int cols = board_ptr->get_columns();
-
-        int bestVal = numeric_limits<int>::min();
-        int bestX = -1, bestY = -1;
-
-        T ai = this->get_symbol();
-        T opp = get_opponent_symbol();
-
-        int maxDepth = get_max_depth();
-
-        for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                if (condition(i, j)) {
-                    vector<T> moveValues = generate_move_values(i, j, true);
-                    for (T moveValue : moveValues) {
-                        Move<T>* move = createMove(i, j);
-                        if (!move) continue;
-                        
-                        board_ptr->update_board(move);
-                        int eval = minimax(board_ptr, false, ai, opp,
-                                           numeric_limits<int>::min(),
-                                           numeric_limits<int>::max(),
-                                           maxDepth);
-                        Move<T>* undoMove = createUndoMove(i, j);
-                        if (undoMove) {
-                            board_ptr->update_board(undoMove);
-                            delete undoMove;
-                        }
-                        delete move;
-                        
-                        if (eval > bestVal) {
-                            bestVal = eval;
-                            bestX = i;
-                            bestY = j;
-                        }
-                    }
-                }
-            }
+        stop_pondering();
+        auto begin = chrono::steady_clock::now();
+        SearchStats move_stats;
+        // A position searched while pondering is answered without searching again
+        Move<T>* move;
+        auto it = pondered.find(board_ptr->get_board_matrix());
+        if (it != pondered.end()) {
+            move = it->second.release();
+            move_stats.pondered = true;
+        } else {
+            move = search_move(board_ptr);
+            move_stats.counters = search_counts;
+            move_stats.depth = search_plies;
         }
+        pondered.clear();
 
-        if (bestX == -1 || bestY == -1) {
-            // Fallback: find first valid move
-            for (int i = 0; i < rows && bestX == -1; i++) {
-                for (int j = 0; j < cols && bestX == -1; j++) {
-                    if (condition(i, j)) {
-                        bestX = i;
-                        bestY = j;
-                    }
-                }
-            }
-        }
+        move_stats.elapsed_ns = elapsed_ns(begin);
+        move_stats.ponder_nodes = ponder_nodes;
+        move_stats.ponder_ns = ponder_ns;
+        ponder_nodes = ponder_ns = 0;
+        stats.report(move_stats, this->get_name());
 
-        return createMove(bestX, bestY);
+        if (ponder_enabled) {
+            unique_ptr<Board<T>> board(board_ptr->clone());
+            if (board->update_board(move))
+                ponder_thread = thread(&AIPlayer::ponder, this, std::move(board));
+        }
+        return move;
     }
 };
 
@@ -0,0 +1,102 @@
+//
+// Created by abdelhamid on 12/14/25.
+//
+
+#ifndef BOARDGAMEFRAMEWORK_BITBOARD_H
+#define BOARDGAMEFRAMEWORK_BITBOARD_H
+
+#include <cstdint>
+#include <cctype>
+
+/**
+ * @brief Bit of cell (x, y) on a board with the given number of columns.
+ */
+constexpr uint32_t cell_bit(int columns, int x, int y) {
+    return 1u << (x * columns + y);
+}
+
+/**
+ * @brief Bit masks of the 8 winning lines of a 3x3 board (3 rows, 3 columns, 2 diagonals).
+ */
+constexpr uint32_t XO_3X3_LINES[8] = {
+    0x007, 0x038, 0x1C0,   // rows
+    0x049, 0x092, 0x124,   // columns
+    0x111, 0x054           // diagonals
+};
+
+/**
+ * @class BitBoard
+ * @brief Compact two-sided cell storage for small boards (up to 32 cells).
+ *
+ * Each side owns one bit per cell (bit index = x * columns + y). Boards keep
+ * their `Board<T>::board` matrix for `get_cell` / `get_board_matrix` and mirror
+ * every placement here, so terminal detection is an AND/compare of a side mask
+ * against precomputed line masks instead of a rescan of the matrix.
+ */
+class BitBoard {
+private:
+    uint32_t masks[2] = {0, 0}; ///< One mask per side.
+    int columns;                ///< Board width used to map (x, y) to a bit.
+
+public:
+    /**
+     * @brief Construct an empty bitboard for a board of the given width.
+     */
+    explicit BitBoard(int columns = 3) : columns(columns) {}
+
+    /**
+     * @brief Map an X-O symbol to a side index.
+     * @return 0 for 'X', 1 for 'O', -1 for anything else.
+     */
+    static int xo_side(char symbol) {
+        char s = static_cast<char>(toupper(static_cast<unsigned char>(symbol)));
+        return s == 'X' ? 0 : (s == 'O' ? 1 : -1);
+    }
+
+    /** @brief Bit of cell (x, y). */
+    uint32_t bit(int x, int y) const { return cell_bit(columns, x, y); }
+
+    /** @brief Mark cell (x, y) as owned by side. */
+    void set(int x, int y, int side) { masks[side] |= bit(x, y); }
+
+    /** @brief Empty cell (x, y) for both sides. */
+    void clear(int x, int y) {
+        masks[0] &= ~bit(x, y);
+        masks[1] &= ~bit(x, y);
+    }
+
+    /** @brief Remove every mark from the board. */
+    void reset() { masks[0] = masks[1] = 0; }
+
+    /**
+     * @brief Side that owns cell (x, y).
+     * @return 0 or 1, or -1 if the cell is empty.
+     */
+    int side_at(int x, int y) const {
+        uint32_t b = bit(x, y);
+        if (masks[0] & b) return 0;
+        if (masks[1] & b) return 1;
+        return -1;
+    }
+
+    /** @brief Mask of the cells owned by side. */
+    uint32_t get_mask(int side) const { return masks[side]; }
+
+    /** @brief Mask of all occupied cells. */
+    uint32_t occupied() const { return masks[0] | masks[1]; }
+
+    /**
+     * @brief Check whether side fully owns at least one of the given lines.
+     * @param side Side index (0 or 1).
+     * @param lines Array of line masks.
+     * @param n Number of lines.
+     */
+    bool has_line(int side, const uint32_t* lines, int n) const {
+        if (side < 0) return false;
+        for (int i = 0; i < n; i++)
+            if ((masks[side] & lines[i]) == lines[i]) return true;
+        return false;
+    }
+};
+
+#endif //BOARDGAMEFRAMEWORK_BITBOARD_H
@@ -11,6 +11,10 @@
 #include <vector>
 #include <iostream>
 #include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 using namespace std;
 
 /////////////////////////////////////////////////////////////
@@ -34,6 +38,52 @@ enum class PlayerType {
     RANDOM     ///< A Random player.
 };
 
+/**
+ * @brief Complete state of a board in a fixed-size block of plain bytes.
+ *
+ * Written by Board::snapshot() and read back by Board::restore(), so a
+ * position can be saved and rolled back with a memcpy instead of replaying or
+ * undoing moves. Snapshots can be kept in arrays, compared with memcmp or sent
+ * over a socket (native byte order). Each board stores its own state struct,
+ * whose TAG names the game, so a board refuses the state of another game even
+ * when both structs have the same layout.
+ */
+struct BoardSnapshot {
+    static constexpr size_t CAPACITY = 256; ///< Bytes available to one board.
+    uint32_t tag = 0;                       ///< TAG of the stored state, 0 for an empty snapshot.
+    uint32_t size = 0;                      ///< Bytes used, 0 for an empty snapshot.
+    unsigned char bytes[CAPACITY];
+
+    /** @brief Tag of a state struct from a four-character name, e.g. make_tag("DIAM"). */
+    static constexpr uint32_t make_tag(const char (&name)[5]) {
+        return uint32_t(uint8_t(name[0])) << 24 | uint32_t(uint8_t(name[1])) << 16 |
+               uint32_t(uint8_t(name[2])) << 8 | uint32_t(uint8_t(name[3]));
+    }
+
+    /**
+     * @brief Store a board's state (plain data of at most CAPACITY bytes, with a static TAG).
+     */
+    template <typename State>
+    void store(const State& state) {
+        static_assert(is_trivially_copyable<State>::value, "board state must be plain data");
+        static_assert(sizeof(State) <= CAPACITY, "board state does not fit in a snapshot");
+        memcpy(bytes, &state, sizeof(State));
+        tag = State::TAG;
+        size = sizeof(State);
+    }
+
+    /**
+     * @brief Read back a state written by store().
+     * @return false if the snapshot holds the state of another game.
+     */
+    template <typename State>
+    bool load(State& state) const {
+        if (tag != State::TAG || size != sizeof(State)) return false;
+        memcpy(&state, bytes, sizeof(State));
+        return true;
+    }
+};
+
 /**
  * @brief Base template for any board used in board games.
  *
@@ -72,6 +122,23 @@ public:
     /** @brief Check if a player has won. */
     virtual bool is_win(Player<T>*) = 0;
 
+    /**
+     * @brief Check if the player using the given symbol has won.
+     *
+     * Boards keep their line state up to date in update_board(), so this is a
+     * cheap lookup that needs no Player object. is_win(Player<T>*) forwards here.
+     */
+    virtual bool is_win(T symbol) = 0;
+
+    /**
+     * @brief Symbol of the player who has won ('X' or 'O'), or T() if nobody has.
+     */
+    virtual T winner() {
+        for (T symbol : {static_cast<T>('X'), static_cast<T>('O')})
+            if (is_win(symbol)) return symbol;
+        return T();
+    }
+
     /** @brief Check if a player has lost. */
     virtual bool is_lose(Player<T>*) = 0;
 
@@ -81,6 +148,26 @@ public:
     /** @brief Check if the game is over. */
     virtual bool game_is_over(Player<T>*) = 0;
 
+    /**
+     * @brief Create an independent copy of the board with the same dynamic type.
+     *
+     * Searches that run on several threads give each worker its own clone to
+     * play and undo moves on. Caller is responsible for deletion.
+     */
+    virtual Board<T>* clone() const = 0;
+
+    /**
+     * @brief Save the complete state of the board (cells, move count and any hidden state).
+     * @return false if the board does not support snapshots or its state does not fit.
+     */
+    virtual bool snapshot(BoardSnapshot& /*s*/) const { return false; }
+
+    /**
+     * @brief Return to a state saved by snapshot() on a board of the same game.
+     * @return false if s does not hold a state of this game.
+     */
+    virtual bool restore(const BoardSnapshot& /*s*/) { return false; }
+
     /**
      * @brief Return a copy of the current board as a 2D vector.
      */
@@ -101,6 +188,19 @@ public:
     T get_cell(int x, int y) {
         return board[x][y];
     }
+
+protected:
+    /** @brief Copy the cells row by row to out (rows * columns values), for snapshot(). */
+    void save_cells(T* out) const {
+        for (auto& row : board)
+            for (const T& cell : row) *out++ = cell;
+    }
+
+    /** @brief Set the cells row by row from in (rows * columns values), for restore(). */
+    void load_cells(const T* in) {
+        for (auto& row : board)
+            for (T& cell : row) cell = *in++;
+    }
 };
 
 //-----------------------------------------------------
@@ -168,6 +268,14 @@ public:
 
     /** @brief Assign the board pointer for the player. */
     void set_board_ptr(Board<T>* b) { boardPtr = b; }
+
+    /**
+     * @brief Stop any search the player runs on the opponent's time.
+     *
+     * GameManager calls it when a game ends. Only computer players that
+     * ponder (see smartPlayer and AIPlayer) have anything to stop.
+     */
+    virtual void stop_pondering() {}
 };
 
 //-----------------------------------------------------
@@ -262,10 +370,79 @@ public:
     }
 };
 
+//-----------------------------------------------------
+/**
+ * @brief Result of a game played by GameManager::run_headless().
+ */
+struct GameOutcome {
+    int winner = -1;         ///< Index of the winning player, -1 for a draw or an unfinished game.
+    bool finished = false;   ///< False if the move or retry limit stopped the game.
+    int moves = 0;           ///< Accepted moves.
+    int moves_by[2] = {0, 0};        ///< Accepted moves of each player.
+    double think_ms[2] = {0.0, 0.0}; ///< Time each player spent in get_move.
+};
+
+//-----------------------------------------------------
+/**
+ * @brief Receives the moves of a game while GameManager plays it (e.g. to save a record).
+ *
+ * @tparam T Type of symbol used on the board.
+ */
+template <typename T>
+class MoveRecorder {
+public:
+    virtual ~MoveRecorder() {}
+
+    /**
+     * @brief A game starts on the board between the two players (players[0] moves first).
+     */
+    virtual void start(const Board<T>& board, Player<T>* const players[2]) = 0;
+
+    /**
+     * @brief A move was accepted by the board.
+     */
+    virtual void record(const Move<T>& move) = 0;
+
+    /**
+     * @brief The game is over.
+     * @param winner Index of the winning player, -1 for a draw or an unfinished game.
+     * @param finished False if the game was stopped before its end.
+     */
+    virtual void finish(int winner, bool finished) = 0;
+};
+
+//-----------------------------------------------------
+/**
+ * @brief Result of GameManager::submit_move().
+ */
+enum class MoveResult {
+    ACCEPTED,  ///< The board took the move (the game may now be over).
+    REJECTED,  ///< The board refused the move; the same player is still to move.
+    GAME_OVER  ///< The game had already ended, nothing was played.
+};
+
+/**
+ * @brief Where a game driven by GameManager::submit_move() stands.
+ */
+struct GameStatus {
+    bool over = false;      ///< No more moves are taken.
+    int turn = 0;           ///< Index of the player to move (while not over).
+    int winner = -1;        ///< Index of the winning player, -1 for a draw or an unfinished game.
+    bool finished = false;  ///< False if the game was stopped before its end.
+    int moves = 0;          ///< Accepted moves.
+};
+
 //-----------------------------------------------------
 /**
  * @brief Controls the flow of a board game between two players.
  *
+ * A game is a state machine: start() it, then hand the move of
+ * pending_player() to submit_move() until poll_state() says it is over.
+ * Nothing blocks, so a host can interleave many games on a few threads and
+ * deliver a computer's move whenever its search ends (compute_move() may run
+ * on another thread as long as no move is submitted meanwhile). run() and
+ * run_headless() drive the same machine with blocking get_move() calls.
+ *
  * @tparam T Type of symbol used on the board.
  */
 template <typename T>
@@ -273,6 +450,17 @@ class GameManager {
     Board<T>* boardPtr;    ///< Game board
     Player<T>* players[2]; ///< Two players
     UI<T>* ui;             ///< User interface
+    MoveRecorder<T>* recorder = nullptr; ///< Receives the accepted moves, if set
+    GameStatus status;     ///< State of the current game
+
+    void end_game(int winner, bool finished) {
+        status.over = true;
+        status.winner = winner;
+        status.finished = finished;
+        if (recorder) recorder->finish(winner, finished);
+        players[0]->stop_pondering();
+        players[1]->stop_pondering();
+    }
 
 public:
     /**
@@ -286,37 +474,127 @@ public:
         players[1]->set_board_ptr(b);
     }
 
+    /**
+     * @brief Send the moves of the next games to recorder (nullptr to stop recording).
+     */
+    void set_recorder(MoveRecorder<T>* r) {
+        recorder = r;
+    }
+
+    /**
+     * @brief Begin a game on the board: the first player is to move.
+     */
+    void start() {
+        status = GameStatus();
+        if (recorder) recorder->start(*boardPtr, players);
+    }
+
+    /**
+     * @brief State of the game: whose turn it is, or how it ended.
+     */
+    const GameStatus& poll_state() const {
+        return status;
+    }
+
+    /**
+     * @brief Player whose move submit_move() expects, nullptr once the game is over.
+     */
+    Player<T>* pending_player() const {
+        return status.over ? nullptr : players[status.turn];
+    }
+
+    /**
+     * @brief Ask the UI (or AI) for the pending player's move (caller deletes it).
+     */
+    Move<T>* compute_move() {
+        return ui->get_move(pending_player());
+    }
+
+    /**
+     * @brief Play a move of the pending player and check whether it ended the game.
+     *
+     * The move stays owned by the caller. Same end conditions, in the same
+     * order, as run(): a win, then a loss of the mover, then a draw.
+     */
+    MoveResult submit_move(Move<T>* move) {
+        if (status.over) return MoveResult::GAME_OVER;
+        if (!boardPtr->update_board(move)) return MoveResult::REJECTED;
+        if (recorder) recorder->record(*move);
+        status.moves++;
+
+        int i = status.turn;
+        Player<T>* currentPlayer = players[i];
+        if (boardPtr->is_win(currentPlayer)) end_game(i, true);
+        else if (boardPtr->is_lose(currentPlayer)) end_game(1 - i, true);
+        else if (boardPtr->is_draw(currentPlayer)) end_game(-1, true);
+        else status.turn = 1 - i;
+        return MoveResult::ACCEPTED;
+    }
+
+    /**
+     * @brief End the game before its end (it counts as unfinished).
+     */
+    void stop() {
+        if (!status.over) end_game(-1, false);
+    }
+
     /**
      * @brief Run the main game loop until someone wins or the game ends.
      */
     void run() {
         ui->display_board_matrix(boardPtr->get_board_matrix());
-        Player<T>* currentPlayer = players[0];
-
-        while (true) {
-            for (int i : {0, 1}) {
-                currentPlayer = players[i];
-                Move<T>* move = ui->get_move(currentPlayer);
-
-                while (!boardPtr->update_board(move))
-                    move = ui->get_move(currentPlayer);
-
-                ui->display_board_matrix(boardPtr->get_board_matrix());
-
-                if (boardPtr->is_win(currentPlayer)) {
-                    ui->display_message(currentPlayer->get_name() + " wins!");
-                    return;
-                }
-                if (boardPtr->is_lose(currentPlayer)) {
-                    ui->display_message(players[1 - i]->get_name() + " wins!");
-                    return;
-                }
-                if (boardPtr->is_draw(currentPlayer)) {
-                    ui->display_message("Draw!");
-                    return;
-                }
+        start();
+
+        while (!status.over) {
+            Move<T>* move = compute_move();
+            while (submit_move(move) == MoveResult::REJECTED) {
+                delete move;
+                move = compute_move();
             }
+            delete move;
+
+            ui->display_board_matrix(boardPtr->get_board_matrix());
         }
+
+        if (status.winner >= 0) ui->display_message(players[status.winner]->get_name() + " wins!");
+        else ui->display_message("Draw!");
+    }
+
+    /**
+     * @brief Play the game to the end without displaying anything.
+     *
+     * Same turn order and end conditions as run(). The game is stopped
+     * (unfinished) after max_moves accepted moves, or when a player has
+     * max_retries moves in a row rejected by the board.
+     */
+    GameOutcome run_headless(int max_moves = 1000, int max_retries = 100) {
+        GameOutcome outcome;
+        start();
+
+        while (!status.over) {
+            int i = status.turn;
+            int rejected = 0;
+            MoveResult result;
+            do {
+                auto begin = chrono::steady_clock::now();
+                Move<T>* move = compute_move();
+                outcome.think_ms[i] += chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+                result = submit_move(move);
+                delete move;
+            } while (result == MoveResult::REJECTED && ++rejected < max_retries);
+
+            if (result == MoveResult::REJECTED) {
+                stop();
+                break;
+            }
+            outcome.moves_by[i]++;
+            if (!status.over && status.moves >= max_moves) stop();
+        }
+
+        outcome.moves = status.moves;
+        outcome.winner = status.winner;
+        outcome.finished = status.finished;
+        return outcome;
     }
 };
 
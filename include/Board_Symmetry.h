@@ -0,0 +1,156 @@
+//
+// Created by abdelhamid on 12/24/25.
+//
+
+#ifndef BOARDGAMEFRAMEWORK_BOARD_SYMMETRY_H
+#define BOARDGAMEFRAMEWORK_BOARD_SYMMETRY_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class BoardSymmetry
+ * @brief The 8 rotations and reflections of an n x n board.
+ *
+ * Transform t (0..7) first swaps rows and columns if bit 2 is set, then mirrors
+ * the rows (x -> n-1-x) if bit 1 is set and the columns (y -> n-1-y) if bit 0
+ * is set; 0 is the identity. Cells are numbered x * n + y.
+ *
+ * A game whose rules look the same from every side can store one entry per
+ * class of equivalent positions: the canonical form is the smallest of the 8
+ * transforms, and a move found on it is brought back to the real board with
+ * inverse() (see canonical()).
+ */
+class BoardSymmetry {
+public:
+    static constexpr int COUNT = 8; ///< Number of transforms.
+
+protected:
+    int n;
+    vector<int> cells; ///< [t * n * n + i]: image of cell i under transform t.
+
+public:
+    explicit BoardSymmetry(int n) : n(n), cells(COUNT * n * n) {
+        for (int t = 0; t < COUNT; t++)
+            for (int x = 0; x < n; x++)
+                for (int y = 0; y < n; y++) {
+                    auto [tx, ty] = map(t, x, y);
+                    cells[t * n * n + x * n + y] = tx * n + ty;
+                }
+    }
+
+    /** @brief Side of the board. */
+    int size() const { return n; }
+
+    /** @brief Image of cell (x, y) under transform t. */
+    pair<int, int> map(int t, int x, int y) const {
+        if (t & 4) swap(x, y);
+        if (t & 2) x = n - 1 - x;
+        if (t & 1) y = n - 1 - y;
+        return {x, y};
+    }
+
+    /** @brief Image of cell i (x * n + y) under transform t. */
+    int cell(int t, int i) const { return cells[t * n * n + i]; }
+
+    /** @brief Transform undoing t. */
+    static int inverse(int t) {
+        // Mirrors after a swap are mirrors of the other axis before it
+        return t & 4 ? 4 | (t & 1) << 1 | (t & 2) >> 1 : t;
+    }
+
+    /** @brief Board b seen through transform t: cell (x, y) of b lands on map(t, x, y). */
+    template <typename T>
+    vector<vector<T>> transform(const vector<vector<T>>& b, int t) const {
+        vector<vector<T>> out = b;
+        for (int x = 0; x < n; x++)
+            for (int y = 0; y < n; y++) {
+                auto [tx, ty] = map(t, x, y);
+                out[tx][ty] = b[x][y];
+            }
+        return out;
+    }
+
+    /**
+     * @brief Canonical form of b: the smallest of its transforms (row by row).
+     * @param t Set to the transform giving it (the lowest one on ties). A move
+     *        (x, y) of the canonical form is map(inverse(t), x, y) on b.
+     */
+    template <typename T>
+    vector<vector<T>> canonical(const vector<vector<T>>& b, int& t) const {
+        vector<vector<T>> best = b;
+        t = 0;
+        for (int k = 1; k < COUNT; k++) {
+            vector<vector<T>> candidate = transform(b, k);
+            if (candidate < best) {
+                best = candidate;
+                t = k;
+            }
+        }
+        return best;
+    }
+};
+
+/**
+ * @class MaskSymmetry
+ * @brief BoardSymmetry on bit masks of the board (cell x * n + y is bit x * n + y, n <= 8).
+ *
+ * A mask is transformed one row at a time through a table of the images of
+ * every row pattern, n lookups per transform.
+ */
+class MaskSymmetry : public BoardSymmetry {
+private:
+    vector<uint64_t> rows; ///< [(t * n + x) << n | pattern]: image of row x holding pattern.
+
+public:
+    explicit MaskSymmetry(int n) : BoardSymmetry(n), rows(size_t(COUNT * n) << n) {
+        for (int t = 0; t < COUNT; t++)
+            for (int x = 0; x < n; x++)
+                for (int pattern = 0; pattern < (1 << n); pattern++) {
+                    uint64_t image = 0;
+                    for (int y = 0; y < n; y++)
+                        if (pattern >> y & 1) image |= uint64_t(1) << cell(t, x * n + y);
+                    rows[size_t(t * n + x) << n | pattern] = image;
+                }
+    }
+
+    /** @brief Image of mask under transform t. */
+    uint64_t transform(uint64_t mask, int t) const {
+        const uint64_t* table = &rows[size_t(t * n) << n];
+        const uint64_t row = (uint64_t(1) << n) - 1;
+        uint64_t out = 0;
+        for (int x = 0; x < n; x++, mask >>= n) out |= table[(size_t(x) << n) | (mask & row)];
+        return out;
+    }
+
+    /**
+     * @brief Hash key shared by the 8 transforms of a position given as the masks of its two sides.
+     * @param t Set to the transform the key is computed on: a move stored for the
+     *        position is cell(t, move), and cell(inverse(t), stored) brings it back.
+     */
+    uint64_t canonical_key(uint64_t first, uint64_t second, int& t) const {
+        uint64_t best = ~uint64_t(0);
+        t = 0;
+        for (int k = 0; k < COUNT; k++) {
+            uint64_t key = pair_key(transform(first, k), transform(second, k));
+            if (key < best) {
+                best = key;
+                t = k;
+            }
+        }
+        return best;
+    }
+
+    /** @brief Well mixed 64-bit key of two masks. */
+    static uint64_t pair_key(uint64_t first, uint64_t second) {
+        uint64_t z = first * 0x9E3779B97F4A7C15ULL ^ second;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+#endif //BOARDGAMEFRAMEWORK_BOARD_SYMMETRY_H
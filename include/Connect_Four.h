@@ -0,0 +1,235 @@
+//
+// Created by abdelhamid on 12/22/25.
+//
+
+#ifndef BOARDGAMEFRAMEWORK_CONNECT_FOUR_H
+#define BOARDGAMEFRAMEWORK_CONNECT_FOUR_H
+
+#include "Search_Stats.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class ConnectFourPosition
+ * @brief 6x7 Connect-4 position as two 64-bit masks.
+ *
+ * Column c owns bits c * 7 .. c * 7 + 5, bottom to top; bit c * 7 + 6 stays
+ * empty as a separator so shifts never wrap into the next column. `current`
+ * holds the pieces of the side to move and `mask` every piece, so a move is
+ * two operations and `current + mask` is a unique key of the position.
+ * Four-in-a-row detection shifts a side's mask along each direction (1 up,
+ * 7 across, 6 and 8 diagonally) and ANDs the copies.
+ */
+class ConnectFourPosition {
+public:
+    static constexpr int WIDTH = 7;
+    static constexpr int HEIGHT = 6;
+    static constexpr int CELLS = WIDTH * HEIGHT;
+
+private:
+    static constexpr int H1 = HEIGHT + 1; ///< Bits per column, separator included.
+
+    static constexpr uint64_t BOTTOM = 0x40810204081ULL; ///< Lowest cell of every column.
+    static constexpr uint64_t BOARD = BOTTOM * ((uint64_t(1) << HEIGHT) - 1);
+
+    uint64_t current = 0; ///< Pieces of the side to move.
+    uint64_t mask = 0;    ///< Every piece.
+    int moves = 0;        ///< Pieces on the board.
+
+    /** @brief Empty cells that would complete a four for the side owning position. */
+    static uint64_t winning_cells(uint64_t position, uint64_t mask) {
+        // vertical: three below
+        uint64_t r = (position << 1) & (position << 2) & (position << 3);
+        for (int shift : {H1, HEIGHT, HEIGHT + 2}) {
+            uint64_t p = (position << shift) & (position << 2 * shift);
+            r |= p & (position << 3 * shift);
+            r |= p & (position >> shift);
+            p = (position >> shift) & (position >> 2 * shift);
+            r |= p & (position << shift);
+            r |= p & (position >> 3 * shift);
+        }
+        return r & (BOARD ^ mask);
+    }
+
+public:
+    ConnectFourPosition() {}
+
+    /**
+     * @brief Read a position from a board matrix (row 0 on top, '.' empty).
+     * @param to_move Symbol of the side to move; every other symbol is the opponent's.
+     */
+    ConnectFourPosition(const vector<vector<char>>& b, char to_move);
+
+    /** @brief Bit of column c's lowest empty cell, 0 if the column is full. */
+    uint64_t column_move(int c) const {
+        return possible() & (((uint64_t(1) << HEIGHT) - 1) << (c * H1));
+    }
+
+    /** @brief Column of a move bit. */
+    static int column_of(uint64_t move) { return __builtin_ctzll(move) / H1; }
+
+    /** @brief Row, counted from the bottom, of a move bit. */
+    static int height_of(uint64_t move) { return __builtin_ctzll(move) % H1; }
+
+    /** @brief Drop a piece of the side to move (move is one bit of possible()). */
+    void play(uint64_t move) {
+        current ^= mask;
+        mask |= move;
+        moves++;
+    }
+
+    /** @brief Lowest empty cell of every column that is not full. */
+    uint64_t possible() const { return (mask + BOTTOM) & BOARD; }
+
+    /** @brief Moves that complete a four for the side to move. */
+    uint64_t winning_moves() const { return winning_cells(current, mask) & possible(); }
+
+    /** @brief Whether the side to move can complete a four with its next piece. */
+    bool can_win_next() const { return winning_moves() != 0; }
+
+    /** @brief Empty cells that would complete a four for the opponent. */
+    uint64_t opponent_threats() const { return winning_cells(current ^ mask, mask); }
+
+    /** @brief Whether the side that just moved owns a four. */
+    bool opponent_has_four() const;
+
+    /**
+     * @brief Moves that do not let the opponent win on the next move.
+     *
+     * Call only when the side to move cannot win at once. 0 means every move
+     * loses: the opponent has two threats to block, or only cells below them.
+     */
+    uint64_t non_losing_moves() const {
+        uint64_t moves_mask = possible();
+        uint64_t opponent_wins = opponent_threats();
+        uint64_t forced = moves_mask & opponent_wins;
+        if (forced) {
+            if (forced & (forced - 1)) return 0; // two threats, one piece
+            moves_mask = forced;
+        }
+        return moves_mask & ~(opponent_wins >> 1); // never play just below a threat
+    }
+
+    /** @brief Threats (cells completing a four) the side to move would own after move. */
+    int threats_after(uint64_t move) const {
+        return __builtin_popcountll(winning_cells(current | move, mask));
+    }
+
+    /** @brief Threats of the side to move minus threats of the opponent. */
+    int threat_balance() const {
+        return __builtin_popcountll(winning_cells(current, mask)) -
+               __builtin_popcountll(winning_cells(current ^ mask, mask));
+    }
+
+    /** @brief Unique key of the position (below 2^49). */
+    uint64_t key() const { return current + mask; }
+
+    int get_moves() const { return moves; }
+};
+
+/**
+ * @class ConnectFourSearch
+ * @brief Negamax alpha-beta engine for ConnectFourPosition.
+ *
+ * best_column() first deepens one ply at a time up to HEURISTIC_PLIES, then
+ * searches to the end of the game with null windows (is there a winning move,
+ * else a drawing one?) until the deadline (stop() returning true). A complete
+ * search usually fits in 100 ms from about the 10th move on, so from mid-game
+ * the engine plays perfectly; before that it plays the move of the deepest
+ * finished iteration. Scores are from the side to move: a win with w of its
+ * own pieces still unplayed scores w * WIN, a draw 0, and a position cut at
+ * the depth limit its threat balance (less than WIN in absolute value).
+ *
+ * Moves are tried table move first, then by the threats they create, then
+ * centre columns first. Losing moves (letting the opponent win at once) are
+ * never searched.
+ *
+ * The transposition table holds one 64-bit word per slot: 32 bits of the key,
+ * score, depth, bound and best column. The table size is an odd prime above
+ * 2^17, so the slot index and the 32 stored bits identify a key below 2^49
+ * exactly (no false hits). The table is allocated on first use and kept
+ * between searches.
+ *
+ * With more than one thread, best_column() runs a Lazy SMP search: helper
+ * threads repeat the search of the main thread (odd helpers one ply deeper,
+ * each trying the root moves from another one first) and share its table.
+ * A slot is a single atomic word, so concurrent writers never leave a torn
+ * entry. The column returned is the main thread's.
+ */
+class ConnectFourSearch {
+public:
+    static constexpr int WIN = 100;          ///< Score of a win per piece left to play.
+    static constexpr int SOLVED = 255;       ///< Depth stored for results of a complete search.
+    static constexpr int HEURISTIC_PLIES = 8; ///< Depth-limited iterations before the complete search.
+    static constexpr size_t DEFAULT_TABLE_SIZE = 524287; ///< 2^19 - 1 slots (4 MB).
+
+private:
+    enum Bound : uint8_t { EXACT, LOWER, UPPER };
+
+    vector<atomic<uint64_t>> table;
+    atomic<uint64_t>* slots = nullptr; ///< The table searched: this one's, or the main thread's for a helper.
+    size_t table_size;
+    const function<bool()>* stop = nullptr; ///< Deadline of the running search.
+    bool aborted = false;
+    int depth_reached = 0;
+    int score = 0;
+    SearchCounters helper_counts; ///< Counted by the helper threads of the last best_column().
+
+    /** @brief Allocate the table on first use. */
+    void allocate();
+    bool probe(uint64_t key, int& value, int& depth, Bound& bound, int& column) const;
+    void store(uint64_t key, int value, int depth, Bound bound, int column);
+
+    int negamax(const ConnectFourPosition& p, int alpha, int beta, int depth);
+
+    /** @brief Search of one thread (0 = main): best_column() on the table in slots. */
+    int search(const ConnectFourPosition& p, int max_depth, int worker);
+
+    /**
+     * @brief Complete search of the root moves, tried from ordered[first] on: sets best to a
+     * winning, else drawing, move; returns WIN, 0 or -WIN.
+     */
+    int solve_root(const ConnectFourPosition& p, const uint64_t ordered[], int n, int first, int& best);
+
+    /** @brief Moves of moves_mask, best first (table column, threats created, centre). */
+    int order_moves(const ConnectFourPosition& p, uint64_t moves_mask, int first_column, uint64_t ordered[]) const;
+
+public:
+    explicit ConnectFourSearch(size_t table_size = DEFAULT_TABLE_SIZE) : table_size(table_size | 1) {}
+
+    /**
+     * @brief Best column for the side to move of p.
+     * @param stop Checked at every node; once it returns true the running iteration is discarded.
+     *        Called from every search thread.
+     * @param max_depth Deepest iteration, in plies.
+     * @param threads Search threads, the calling one included (Lazy SMP above 1).
+     * @return A column, or -1 if the board is full or the game is over.
+     */
+    int best_column(const ConnectFourPosition& p, const function<bool()>& stop,
+                    int max_depth = ConnectFourPosition::CELLS, int threads = 1);
+
+    /** @brief Exact score of p (see the class description), without time limit. */
+    int solve(const ConnectFourPosition& p);
+
+    /** @brief Plies of the deepest iteration completed by the last best_column(). */
+    int last_depth() const { return depth_reached; }
+
+    /** @brief Score of the move returned by the last best_column() (after a complete search: WIN, 0 or -WIN). */
+    int last_score() const { return score; }
+
+    /** @brief Nodes and table probes of the helper threads of the last best_column() (the caller counts its own). */
+    const SearchCounters& helper_counters() const { return helper_counts; }
+
+    /** @brief Drop every stored position. */
+    void clear() {
+        table = vector<atomic<uint64_t>>();
+        slots = nullptr;
+    }
+};
+
+#endif //BOARDGAMEFRAMEWORK_CONNECT_FOUR_H
@@ -4,11 +4,123 @@
 
 #include <bits/stdc++.h>
 #include "BoardGame_Classes.h"
+#include "BitBoard.h"
+#include "Board_Symmetry.h"
 #include "Smart_Player.h"
+#include "Transposition_Table.h"
+
+/**
+ * @brief Directions of the diamond's lines as (dx, dy): horizontal, vertical, main diagonal, anti-diagonal.
+ */
+constexpr int DIAMOND_DIRECTIONS[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+
+/**
+ * @brief Whether cell (x, y) of the 7x7 grid belongs to the diamond (Manhattan distance <= 3 from the centre).
+ */
+constexpr bool diamond_inside(int x, int y) {
+    return x >= 0 && x < 7 && y >= 0 && y < 7 && (x < 3 ? 3 - x : x - 3) + (y < 3 ? 3 - y : y - 3) <= 3;
+}
+
+/**
+ * @brief Bit of cell (x, y) in a diamond mask (bit x * 7 + y).
+ */
+constexpr uint64_t diamond_bit(int x, int y) {
+    return uint64_t(1) << (x * 7 + y);
+}
+
+/**
+ * @brief Precomputed masks of the diamond, see DiamondBits.
+ */
+struct DiamondMasks {
+    uint64_t cells = 0;         ///< The 25 cells of the diamond.
+    uint64_t run_starts[4][9] = {}; ///< [direction][length]: first cells of the runs of that length inside the diamond.
+    uint64_t weights[9] = {};   ///< [w]: cells of positional weight w (centre 8, tips 1).
+};
+
+constexpr DiamondMasks diamond_masks() {
+    const int position_weights[7][7] = {
+        {0, 0, 0, 1, 0, 0, 0},
+        {0, 0, 2, 3, 2, 0, 0},
+        {0, 2, 4, 5, 4, 2, 0},
+        {1, 3, 5, 8, 5, 3, 1},
+        {0, 2, 4, 5, 4, 2, 0},
+        {0, 0, 2, 3, 2, 0, 0},
+        {0, 0, 0, 1, 0, 0, 0}
+    };
+    DiamondMasks m;
+    for (int x = 0; x < 7; x++)
+        for (int y = 0; y < 7; y++) {
+            if (!diamond_inside(x, y)) continue;
+            m.cells |= diamond_bit(x, y);
+            m.weights[position_weights[x][y]] |= diamond_bit(x, y);
+            for (int d = 0; d < 4; d++)
+                for (int length = 1; length < 9; length++) {
+                    int last_x = x + (length - 1) * DIAMOND_DIRECTIONS[d][0];
+                    int last_y = y + (length - 1) * DIAMOND_DIRECTIONS[d][1];
+                    if (diamond_inside(last_x, last_y)) m.run_starts[d][length] |= diamond_bit(x, y);
+                }
+        }
+    return m;
+}
+
+constexpr DiamondMasks DIAMOND_MASKS = diamond_masks();
+
+/**
+ * @class DiamondBits
+ * @brief Runs and wins of one side of the diamond, given as a mask of its cells.
+ *
+ * Moving one cell along direction d adds SHIFTS[d] to the bit index, so the
+ * cells starting a run of k pieces are side & (side >> s) & ... & (side >> (k-1) s),
+ * restricted to the precomputed starts of the runs of length k that stay in
+ * the diamond (a run never wraps around the grid). Each start bit stands for
+ * one segment, so the win rule is a handful of mask tests.
+ */
+class DiamondBits {
+public:
+    static constexpr int SHIFTS[4] = {1, 7, 8, 6}; ///< Bit step of each direction of DIAMOND_DIRECTIONS.
+
+    /** @brief Mask of the cells of b holding symbol. */
+    static uint64_t from_matrix(const vector<vector<char>>& b, char symbol) {
+        uint64_t side = 0;
+        for (int x = 0; x < 7; x++)
+            for (int y = 0; y < 7; y++)
+                if (b[x][y] == symbol) side |= diamond_bit(x, y);
+        return side;
+    }
+
+    /** @brief First cells of the runs of length pieces of side in direction d. */
+    static uint64_t runs(uint64_t side, int d, int length) {
+        uint64_t r = side & DIAMOND_MASKS.run_starts[d][length];
+        for (int k = 1; k < length && r; k++) r &= side >> (k * SHIFTS[d]);
+        return r;
+    }
+
+    /** @brief Longest run of side in direction d (0 without pieces). */
+    static int longest_run(uint64_t side, int d) {
+        int length = 0;
+        for (uint64_t r = side & DIAMOND_MASKS.cells; r; length++)
+            r &= (side >> ((length + 1) * SHIFTS[d])) & DIAMOND_MASKS.run_starts[d][length + 2];
+        return length;
+    }
+
+    /** @brief A run of 4 in one direction and a run of 3 in another. */
+    static bool is_win(uint64_t side) {
+        int threes = 0, fours = 0;
+        for (int d = 0; d < 4; d++) {
+            if (!runs(side, d, 3)) continue;
+            threes |= 1 << d;
+            if (runs(side, d, 4)) fours |= 1 << d;
+        }
+        for (int d = 0; d < 4; d++)
+            if ((fours >> d & 1) && (threes & ~(1 << d))) return true;
+        return false;
+    }
+};
 
 class Diamond_Tic_Tac_Toe_Board : public Board<char> {
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
+    uint64_t sides[2] = {0, 0}; ///< Diamond masks of X and O (see DiamondBits).
 
 public:
     /**
@@ -28,7 +140,14 @@ public:
      * @param player Pointer to the player being checked.
      * @return true if the player has a winning line, false otherwise.
      */
-    bool is_win(Player<char>* player);
+    bool is_win(Player<char>* player) { return is_win(player->get_symbol()); }
+
+    /**
+     * @brief Checks if the player using the given symbol has won the game.
+     * @param symbol Symbol of the player being checked.
+     * @return true if the player has a winning line, false otherwise.
+     */
+    bool is_win(char symbol);
 
     /**
      * @brief Checks if the given player has lost the game.
@@ -51,6 +170,15 @@ public:
      */
     bool game_is_over(Player<char>* player);
 
+    /** @brief Independent copy of the board, used by multi-threaded searches. */
+    Board<char>* clone() const { return new Diamond_Tic_Tac_Toe_Board(*this); }
+
+    /** @brief Save the cells and move count; the masks are rebuilt on restore (see Board::snapshot()). */
+    bool snapshot(BoardSnapshot& s) const;
+
+    /** @brief Return to a state saved by snapshot(). */
+    bool restore(const BoardSnapshot& s);
+
     virtual ~Diamond_Tic_Tac_Toe_Board() {};
 };
 
@@ -108,10 +236,13 @@ public:
 class DiamondSmartPlayer : public smartPlayer<char> {
 public:
     /**
-     * @brief Calculate the best move through Minmax algorithms.
-     * @return the best (x,y) coordinates for computer Move
+     * @brief Construct the Diamond AI. Moves are chosen by the iterative deepening
+     * search of smartPlayer within its time budget.
      */
-    virtual pair<int,int> calculateMove() override;
+    DiamondSmartPlayer(string n, char s, PlayerType t) : smartPlayer<char>(n, s, t) {}
+
+    /** @brief Stops pondering first: the pondering search uses the table and the overrides of this class. */
+    ~DiamondSmartPlayer() override { stop_pondering(); }
 
     /**
      * @return the opponent_symbol depending on game
@@ -119,6 +250,42 @@ public:
     virtual char get_opponent_symbol() const override;
     virtual int evaluate_board(const vector<vector<char>>& b, char ai, char opp, int N = 3) const override;
     virtual bool is_win(const vector<vector<char>>& b, char symbol, int N = 3) const override;
+
+protected:
+    /** @brief Positional weight of the cell (centre 8, tips 1, outside 0): the prior of the move ordering. */
+    int move_prior(int x, int y, int rows, int cols) const override;
+
+    /**
+     * @brief Lazy SMP instead of the root split: with search_threads above 1, helper
+     * threads run the same iterative deepening as the main thread (odd helpers one ply
+     * deeper, each starting with another root move) and share the transposition table.
+     * The move is the main thread's.
+     */
+    pair<int,int> search_best_move(vector<vector<char>>& b) override;
+
+private:
+    SharedTranspositionTable table{18}; ///< Shared by the threads of a search, kept across moves.
+
+    /// A win scores this plus the remaining depth: above every evaluate_bits() score (100000 at most),
+    /// so wins beat heuristic threats and the table can tell them apart (see TableScore).
+    static constexpr int WIN_SCORE = 1000000;
+
+    /**
+     * @brief minimax of smartPlayer on masks: same move ordering, wins scored from WIN_SCORE,
+     * plus a transposition table. The diamond looks the same after any rotation or reflection,
+     * so the 8 symmetric positions share one entry (see MaskSymmetry::canonical_key()).
+     */
+    int minimax_bits(uint64_t ai, uint64_t opp, bool maximizingPlayer, int alpha, int beta, int depth);
+
+    /**
+     * @brief Iterative deepening of one search thread until the deadline.
+     * @param worker 0 for the main thread, which reports the plies it completed in search_plies.
+     * @return Root cell (x * 7 + y) of the deepest completed iteration, -1 if none completed.
+     */
+    int deepen(uint64_t ai, uint64_t opp, int worker);
+
+    /** @brief evaluate_board on masks. */
+    static int evaluate_bits(uint64_t ai, uint64_t opp);
 };
 
 #endif //BOARDGAMEFRAMEWORK_DIAMOND_TIC_TAC_TOE_H
\ No newline at end of file
@@ -12,6 +12,8 @@
 
 #include <bits/stdc++.h>
 #include "BoardGame_Classes.h"
+#include "BitBoard.h"
+#include "Line_Counter.h"
 
 using namespace std ;
 
@@ -29,6 +31,7 @@ using namespace std ;
 class Four_in_a_row_Board : public Board<char> {
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
+    LineCounter lines;       ///< Every run of 4 cells, updated on each drop.
 
 public:
     /**
@@ -48,7 +51,14 @@ public:
      * @param player Pointer to the player being checked.
      * @return true if the player has a winning line, false otherwise.
      */
-    bool is_win(Player<char>* player);
+    bool is_win(Player<char>* player) { return is_win(player->get_symbol()); }
+
+    /**
+     * @brief Checks if the player using the given symbol has won the game.
+     * @param symbol Symbol of the player being checked.
+     * @return true if the player has a winning line, false otherwise.
+     */
+    bool is_win(char symbol);
 
     /**
      * @brief Checks if the given player has lost the game.
@@ -71,6 +81,15 @@ public:
      */
     bool game_is_over(Player<char>* player);
 
+    /** @brief Independent copy of the board, used by multi-threaded searches. */
+    Board<char>* clone() const { return new Four_in_a_row_Board(*this); }
+
+    /** @brief Save the cells and move count; the line counts are rebuilt on restore (see Board::snapshot()). */
+    bool snapshot(BoardSnapshot& s) const;
+
+    /** @brief Return to a state saved by snapshot(). */
+    bool restore(const BoardSnapshot& s);
+
 };
 
 /**
@@ -6,6 +6,8 @@
 #define BOARDGAMEFRAMEWORK_FOUR_FOUR_XO_H
 #include "BoardGame_Classes.h"
 #include "AiPlayer.h"
+#include "BitBoard.h"
+#include "Line_Counter.h"
 #include <limits>
 #include <vector>
 #include <utility>
@@ -17,6 +19,7 @@ using namespace std;
  */
 class Four_Four_XO_Board : public Board<char> {
     char blank_symbol = '.';
+    LineCounter lines; ///< Winning lines, updated as pieces slide.
 
 public:
     /** Default constructor of 4*4 Board Size */
@@ -29,7 +32,10 @@ public:
     virtual bool update_board(Move<char>* move);
 
     /** @brief Check if a player has won. */
-    virtual bool is_win(Player<char>*);
+    virtual bool is_win(Player<char>* player) { return is_win(player->get_symbol()); }
+
+    /** @brief Check if the player using the given symbol has won. */
+    virtual bool is_win(char symbol);
 
     /** @brief Check if a player has lost. */
     virtual bool is_lose(Player<char>*) {return false;};
@@ -40,6 +46,15 @@ public:
     /** @brief Check if the game is over. */
     virtual bool game_is_over(Player<char>*);
 
+    /** @brief Independent copy of the board, used by multi-threaded searches. */
+    virtual Board<char>* clone() const { return new Four_Four_XO_Board(*this); }
+
+    /** @brief Save the cells and move count; the line counts are rebuilt on restore (see Board::snapshot()). */
+    bool snapshot(BoardSnapshot& s) const;
+
+    /** @brief Return to a state saved by snapshot(). */
+    bool restore(const BoardSnapshot& s);
+
     /** Destructor */
     virtual ~Four_Four_XO_Board() {};
 
@@ -93,8 +108,7 @@ protected:
     /**
      * @brief Check if position has a piece belonging to the player that can be moved.
      */
-    virtual bool condition(int x, int y) override {
-        Board<char>* board_ptr = this->get_board_ptr();
+    virtual bool condition(Board<char>* board_ptr, int x, int y) override {
         if (!board_ptr) return false;
         if (x < 0 || x >= board_ptr->get_rows() || y < 0 || y >= board_ptr->get_columns()) {
             return false;
@@ -106,8 +120,7 @@ protected:
     /**
      * @brief Check if position has a piece belonging to a specific symbol.
      */
-    bool condition_for_symbol(int x, int y, char symbol) {
-        Board<char>* board_ptr = this->get_board_ptr();
+    bool condition_for_symbol(Board<char>* board_ptr, int x, int y, char symbol) {
         if (!board_ptr) return false;
         if (x < 0 || x >= board_ptr->get_rows() || y < 0 || y >= board_ptr->get_columns()) {
             return false;
@@ -117,153 +130,165 @@ protected:
     }
     
     /**
-     * @brief Helper to create undo move for any symbol.
+     * @brief Slide back a piece moved from (x, y) by (dx, dy), using a stack move.
      */
-    Move<char>* createUndoMoveForSymbol(int x, int y, int dx, int dy, char symbol) {
+    void undo_slide(Board<char>* boardPtr, int x, int y, int dx, int dy, char symbol) {
         // After move, piece is at (x+dx, y+dy). To undo, move it back to (x, y)
         // So move from (x+dx, y+dy) with direction (-dx, -dy)
-        return new dualMove(x + dx, y + dy, symbol, -dy, -dx);
+        dualMove undo(x + dx, y + dy, symbol, -dy, -dx);
+        boardPtr->update_board(&undo);
+    }
+
+    /**
+     * @brief Key change produced by sliding a piece of side from (x, y) to (x+dx, y+dy).
+     */
+    uint64_t slide_hash(int x, int y, int dx, int dy, int side) {
+        return zobrist.piece(x, y, side) ^ zobrist.piece(x + dx, y + dy, side) ^ zobrist.side_to_move();
+    }
+
+    /**
+     * @brief Moves are slides, numbered (x * cols + y) * 4 + direction; the prior of a slide
+     * is the centre preference of the cell it reaches.
+     */
+    void start_move_ordering(Board<char>* board_ptr) override {
+        int rows = board_ptr->get_rows();
+        int cols = board_ptr->get_columns();
+        move_priors.assign(rows * cols * 4, 0);
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < cols; j++)
+                for (int d = 0; d < 4; d++) {
+                    int x = i + directions[d].first, y = j + directions[d].second;
+                    if (x >= 0 && x < rows && y >= 0 && y < cols)
+                        move_priors[(i * cols + j) * 4 + d] = move_prior(x, y, rows, cols);
+                }
+        ordering_search = MoveOrdering::new_search();
     }
 
     /**
      * @brief Override minimax to handle opponent pieces correctly.
+     *
+     * Moves are indexed as (x * cols + y) * 4 + direction for the transposition table
+     * and the move ordering.
      */
-    int minimax(Board<char>* boardPtr, bool maximizingPlayer, char ai, char opp, int alpha, int beta, int depth, int N = 3) {
+    int minimax(Board<char>* boardPtr, bool maximizingPlayer, char ai, char opp, int alpha, int beta, int depth,
+                uint64_t key, TranspositionTable& table, int N = 3) {
+        if (ponder_stop.load(memory_order_relaxed)) return 0; // the pondering search is thrown away
+        SearchCounters& counters = thread_search_counters();
+        counters.nodes++;
+
         // Terminal conditions
-        if (boardPtr->is_win(this)) return 1000 + depth;
-        
-        Player<char>* tempOpp = new Player<char>("temp", opp, PlayerType::AI);
-        tempOpp->set_board_ptr(boardPtr);
-        if (boardPtr->is_win(tempOpp)) {
-            delete tempOpp;
-            return -1000 - depth;
-        }
-        delete tempOpp;
+        if (boardPtr->is_win(ai)) return 1000 + depth;
+        if (boardPtr->is_win(opp)) return -1000 - depth;
         
         if (boardPtr->is_draw(this)) return 0;
-        if (depth == 0) return evaluate_board(boardPtr, ai, opp, N);
+        if (depth == 0) {
+            counters.leaves++;
+            return evaluate_board(boardPtr, ai, opp, N);
+        }
         
         int rows = boardPtr->get_rows();
         int cols = boardPtr->get_columns();
-        
-        if (maximizingPlayer) {
-            int best = numeric_limits<int>::min();
-            for (int i = 0; i < rows; i++) {
-                for (int j = 0; j < cols; j++) {
-                    // Check for AI's pieces
-                    if (!condition_for_symbol(i, j, ai)) continue;
-                    
-                    for (auto& dir : directions) {
-                        int dx = dir.first;
-                        int dy = dir.second;
-                        if (i + dx < 0 || i + dx >= rows || j + dy < 0 || j + dy >= cols) continue;
-                        if (boardPtr->get_cell(i + dx, j + dy) != blank_symbol) continue;
-                        
-                        // Try the move
-                        Move<char>* move = new dualMove(i, j, ai, dy, dx);
-                        if (!move) continue;
-                        
-                        if (boardPtr->update_board(move)) {
-                            int val = minimax(boardPtr, false, ai, opp, alpha, beta, depth - 1, N);
-                            
-                            // Undo the move - move piece back from (i+dx, j+dy) to (i, j)
-                            Move<char>* undomove = createUndoMoveForSymbol(i, j, dx, dy, ai);
-                            if (undomove && boardPtr->update_board(undomove)) {
-                                delete undomove;
-                            } else {
-                                // Undo failed - this should never happen but handle it
-                                delete undomove;
-                            }
-                            delete move;
-                            
-                            best = max(best, val);
-                            alpha = max(alpha, best);
-                            if (beta <= alpha) {
-                                return best;
-                            }
-                        } else {
-                            delete move;
-                        }
-                    }
-                }
+
+        // Transposition table: pieces slide back and forth, so positions repeat a lot
+        int alphaOrig = alpha, betaOrig = beta;
+        int ttMove = -1;
+        TTEntry entry;
+        counters.tt_probes++;
+        if (table.probe(key, entry)) {
+            counters.tt_hits++;
+            ttMove = entry.best_move;
+            if (entry.depth >= depth) {
+                int value = TableScore::from_table(entry.value, depth);
+                if (entry.flag == BoundType::EXACT) return value;
+                if (entry.flag == BoundType::LOWER) alpha = max(alpha, value);
+                else beta = min(beta, value);
+                if (beta <= alpha) return value;
             }
-            return best;
-        } else {
-            int best = numeric_limits<int>::max();
-            for (int i = 0; i < rows; i++) {
-                for (int j = 0; j < cols; j++) {
-                    // Check for opponent's pieces
-                    if (!condition_for_symbol(i, j, opp)) continue;
-                    
-                    for (auto& dir : directions) {
-                        int dx = dir.first;
-                        int dy = dir.second;
-                        if (i + dx < 0 || i + dx >= rows || j + dy < 0 || j + dy >= cols) continue;
-                        if (boardPtr->get_cell(i + dx, j + dy) != blank_symbol) continue;
-                        
-                        // Create move with opponent's symbol
-                        Move<char>* move = new dualMove(i, j, opp, dy, dx);
-                        if (!move) continue;
-                        
-                        if (boardPtr->update_board(move)) {
-                            int val = minimax(boardPtr, true, ai, opp, alpha, beta, depth - 1, N);
-                            
-                            // Undo the move - move piece back from (i+dx, j+dy) to (i, j)
-                            Move<char>* undomove = createUndoMoveForSymbol(i, j, dx, dy, opp);
-                            if (undomove && boardPtr->update_board(undomove)) {
-                                delete undomove;
-                            } else {
-                                // Undo failed - this should never happen but handle it
-                                delete undomove;
-                            }
-                            delete move;
-                            
-                            best = min(best, val);
-                            beta = min(beta, best);
-                            if (beta <= alpha) {
-                                return best;
-                            }
-                        } else {
-                            delete move;
-                        }
-                    }
+        }
+
+        char mover = maximizingPlayer ? ai : opp;
+        int side = maximizingPlayer ? 0 : 1;
+        int best = maximizingPlayer ? numeric_limits<int>::min() : numeric_limits<int>::max();
+        int bestMove = -1;
+        int tried = 0; // index of the slide being searched, for the cutoff statistics
+        MoveOrdering& ordering = move_ordering();
+
+        // Returns true on an alpha-beta cutoff
+        auto try_move = [&](int i, int j, int d) {
+            int dx = directions[d].first;
+            int dy = directions[d].second;
+
+            dualMove move(i, j, mover, dy, dx);
+            if (!boardPtr->update_board(&move)) return false;
+            int val = minimax(boardPtr, !maximizingPlayer, ai, opp, alpha, beta, depth - 1,
+                              key ^ slide_hash(i, j, dx, dy, side), table, N);
+
+            // Undo the move - move piece back from (i+dx, j+dy) to (i, j)
+            undo_slide(boardPtr, i, j, dx, dy, mover);
+
+            if (maximizingPlayer ? val > best : val < best) {
+                best = val;
+                bestMove = (i * cols + j) * 4 + d;
+            }
+            if (maximizingPlayer) alpha = max(alpha, best);
+            else beta = min(beta, best);
+            if (beta <= alpha) {
+                counters.cutoff(tried);
+                ordering.cutoff((i * cols + j) * 4 + d, depth);
+                return true;
+            }
+            tried++;
+            return false;
+        };
+
+        // Slides of the mover's pieces to an empty neighbour: table move first, then killers, history and priors
+        int moves[MoveOrdering::MAX_MOVES];
+        int n = 0;
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < cols; j++) {
+                if (!condition_for_symbol(boardPtr, i, j, mover)) continue;
+                for (int d = 0; d < (int)directions.size() && n < MoveOrdering::MAX_MOVES; d++) {
+                    int x = i + directions[d].first, y = j + directions[d].second;
+                    if (x >= 0 && x < rows && y >= 0 && y < cols && boardPtr->get_cell(x, y) == blank_symbol)
+                        moves[n++] = (i * cols + j) * 4 + d;
                 }
             }
-            return best;
+        ordering.order(moves, n, depth, ttMove);
+        for (int k = 0; k < n; k++)
+            if (try_move(moves[k] / 4 / cols, moves[k] / 4 % cols, moves[k] % 4)) break;
+
+        if (bestMove >= 0 && !ponder_stop.load(memory_order_relaxed)) {
+            BoundType flag = best <= alphaOrig ? BoundType::UPPER
+                           : best >= betaOrig ? BoundType::LOWER : BoundType::EXACT;
+            table.store(key, depth, TableScore::to_table(best, depth), flag, bestMove);
         }
+        return best;
     }
 
     /**
      * @brief Evaluate board position with heuristic.
      */
-    virtual int evaluate_board(Board<char>* boardPtr, char ai, char opp, int N = 3) override {
-        if (boardPtr->is_win(this)) return 1000;
-        
-        Player<char>* tempOpp = new Player<char>("temp", opp, PlayerType::AI);
-        tempOpp->set_board_ptr(boardPtr);
-        if (boardPtr->is_win(tempOpp)) {
-            delete tempOpp;
-            return -1000;
-        }
-        delete tempOpp;
+    virtual int evaluate_board(Board<char>* boardPtr, char ai, char opp, int /*N*/ = 3) override {
+        if (boardPtr->is_win(ai)) return 1000;
+        if (boardPtr->is_win(opp)) return -1000;
         
         // Simple heuristic: count pieces in winning positions
         // Check for 2 in a row (potential win)
         int score = 0;
-        auto board = boardPtr->get_board_matrix();
-        int rows = board.size();
-        int cols = board[0].size();
+        int rows = boardPtr->get_rows();
+        int cols = boardPtr->get_columns();
         char blank = '.';
         
-        // Check for potential winning lines
+        // Check for potential winning lines (cells read in place, the matrix is not copied)
         auto count_line = [&](int x, int y, int dx, int dy, char sym) -> int {
             int count = 0;
             for (int k = 0; k < 3; k++) {
                 int nx = x + k * dx;
                 int ny = y + k * dy;
                 if (nx >= 0 && nx < rows && ny >= 0 && ny < cols) {
-                    if (board[nx][ny] == sym) count++;
-                    else if (board[nx][ny] != blank) return -1; // blocked
+                    char cell = boardPtr->get_cell(nx, ny);
+                    if (cell == sym) count++;
+                    else if (cell != blank) return -1; // blocked
                 }
             }
             return count;
@@ -294,19 +319,36 @@ protected:
         return score;
     }
 
-public:
-    FourFourAIPlayer(string n, char s, PlayerType t) 
-        : AIPlayer<char>(n, s, t, '.', 3), current_dx(0), current_dy(0) {
-        directions = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}}; // Up, Right, Down, Left
+    /**
+     * @brief Snapshot every slide of an opponent piece (for pondering).
+     */
+    virtual void opponent_replies(Board<char>* board_ptr, vector<BoardSnapshot>& replies) override {
+        char opp = get_opponent_symbol();
+        int rows = board_ptr->get_rows();
+        int cols = board_ptr->get_columns();
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                if (!condition_for_symbol(board_ptr, i, j, opp)) continue;
+                for (auto& dir : directions) {
+                    int dx = dir.first;
+                    int dy = dir.second;
+                    if (i + dx < 0 || i + dx >= rows || j + dy < 0 || j + dy >= cols) continue;
+                    if (board_ptr->get_cell(i + dx, j + dy) != blank_symbol) continue;
+
+                    dualMove move(i, j, opp, dy, dx);
+                    if (!board_ptr->update_board(&move)) continue;
+                    BoardSnapshot reply;
+                    if (board_ptr->snapshot(reply)) replies.push_back(reply);
+                    undo_slide(board_ptr, i, j, dx, dy, opp);
+                }
+            }
+        }
     }
 
     /**
-     * @brief Override calculateMove to handle direction-based moves.
+     * @brief Search for the best slide (the move carries its direction).
      */
-    virtual Move<char>* calculateMove() override {
-        Board<char>* board_ptr = this->get_board_ptr();
-        if (!board_ptr) throw runtime_error("Board not assigned to player!");
-
+    virtual Move<char>* search_move(Board<char>* board_ptr) override {
         int rows = board_ptr->get_rows();
         int cols = board_ptr->get_columns();
 
@@ -318,61 +360,92 @@ public:
 
         int maxDepth = get_max_depth();
 
-        // Iterate over all positions
+        uint64_t rootKey = compute_hash(board_ptr, ai, opp, true);
+        int ttMove = -1;
+        TTEntry entry;
+        if (tt.probe(rootKey, entry)) ttMove = entry.best_move;
+
+        // Legal slides as (x * cols + y) * 4 + direction, remembered best move first
+        auto legal = [&](int i, int j, int d) {
+            int dx = directions[d].first;
+            int dy = directions[d].second;
+            if (i + dx < 0 || i + dx >= rows || j + dy < 0 || j + dy >= cols) return false;
+            return board_ptr->get_cell(i + dx, j + dy) == blank_symbol;
+        };
+        vector<int> roots;
+        if (ttMove >= 0 && ttMove < rows * cols * 4 && condition(board_ptr, ttMove / 4 / cols, ttMove / 4 % cols)
+            && legal(ttMove / 4 / cols, ttMove / 4 % cols, ttMove % 4))
+            roots.push_back(ttMove);
         for (int i = 0; i < rows; i++) {
             for (int j = 0; j < cols; j++) {
                 // Check if position has player's piece
-                if (!condition(i, j)) continue;
-                
+                if (!condition(board_ptr, i, j)) continue;
+
                 // Try each direction
-                for (auto& dir : directions) {
-                    int dx = dir.first;
-                    int dy = dir.second;
-                    
-                    // Check if move is valid
-                    if (i + dx < 0 || i + dx >= rows || j + dy < 0 || j + dy >= cols) continue;
-                    if (board_ptr->get_cell(i + dx, j + dy) != blank_symbol) continue;
-                    
-                    // Try the move
-                    current_dx = dx;
-                    current_dy = dy;
-                    Move<char>* move = createMove(i, j);
-                    if (!move) continue;
-                    
-                    if (board_ptr->update_board(move)) {
-                        int eval = minimax(board_ptr, false, ai, opp,
-                                          numeric_limits<int>::min(),
-                                          numeric_limits<int>::max(),
-                                          maxDepth);
-                        
-                        // Undo the move - move piece back from (i+dx, j+dy) to (i, j)
-                        Move<char>* undoMove = createUndoMoveForSymbol(i, j, dx, dy, ai);
-                        if (undoMove && board_ptr->update_board(undoMove)) {
-                            delete undoMove;
-                        } else {
-                            delete undoMove;
-                        }
-                        delete move;
-                        
-                        if (eval > bestVal) {
-                            bestVal = eval;
-                            bestX = i;
-                            bestY = j;
-                            bestDx = dx;
-                            bestDy = dy;
-                        }
-                    } else {
-                        delete move;
-                    }
+                for (int d = 0; d < (int)directions.size(); d++) {
+                    if ((i * cols + j) * 4 + d == ttMove) continue;
+                    if (legal(i, j, d)) roots.push_back((i * cols + j) * 4 + d);
                 }
             }
         }
 
+        int threads = min(resolve_search_threads(search_threads), max(1, (int)roots.size() - 1));
+        SearchWorkers workers(this, board_ptr, threads);
+        vector<SearchCounters> counted(threads);
+        RootBest rootBest;
+
+        auto search_root = [&](int worker, int k) {
+            Board<char>* wb = workers.boards[worker];
+            int i = roots[k] / 4 / cols, j = roots[k] / 4 % cols;
+            int dx = directions[roots[k] % 4].first;
+            int dy = directions[roots[k] % 4].second;
+
+            dualMove move(i, j, ai, dy, dx);
+            int alpha = rootBest.alpha();
+            if (wb->update_board(&move)) {
+                int eval = count_search(counted[worker], [&] {
+                    return minimax(wb, false, ai, opp,
+                                   alpha,
+                                   numeric_limits<int>::max(),
+                                   maxDepth, rootKey ^ slide_hash(i, j, dx, dy, 0), *workers.tables[worker]);
+                });
+
+                // Undo the move - move piece back from (i+dx, j+dy) to (i, j)
+                undo_slide(wb, i, j, dx, dy, ai);
+
+                rootBest.offer(k, eval, alpha);
+            }
+        };
+
+        // The first root move sets the bound alone, the rest are split across the workers
+        if (!roots.empty()) search_root(0, 0);
+        run_root_split((int)roots.size() - 1, threads, [&](int worker, int k) { search_root(worker, k + 1); });
+
+        search_counts = SearchCounters();
+        for (auto& c : counted) search_counts.add(c);
+        search_plies = maxDepth + 1;
+
+        if (rootBest.best_index() >= 0) {
+            int move = roots[rootBest.best_index()];
+            bestVal = rootBest.alpha();
+            bestX = move / 4 / cols;
+            bestY = move / 4 % cols;
+            bestDx = directions[move % 4].first;
+            bestDy = directions[move % 4].second;
+        }
+
+        if (bestX != -1 && !ponder_stop) {
+            int bestDir = 0;
+            for (int d = 0; d < (int)directions.size(); d++)
+                if (directions[d] == make_pair(bestDx, bestDy)) bestDir = d;
+            tt.store(rootKey, maxDepth + 1, TableScore::to_table(bestVal, maxDepth + 1), BoundType::EXACT, (bestX * cols + bestY) * 4 + bestDir);
+        }
+
         if (bestX == -1 || bestY == -1) {
             // Fallback: find first valid move
             for (int i = 0; i < rows && bestX == -1; i++) {
                 for (int j = 0; j < cols && bestX == -1; j++) {
-                    if (condition(i, j)) {
+                    if (condition(board_ptr, i, j)) {
                         for (auto& dir : directions) {
                             int dx = dir.first;
                             int dy = dir.second;
@@ -396,6 +469,17 @@ public:
         return createMove(bestX, bestY);
     }
 
+public:
+    using AIPlayer<char>::condition;
+
+    FourFourAIPlayer(string n, char s, PlayerType t) 
+        : AIPlayer<char>(n, s, t, '.', 8), current_dx(0), current_dy(0) {
+        directions = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}}; // Up, Right, Down, Left
+    }
+
+    /** @brief Stops pondering first: the pondering search calls the overrides of this class. */
+    ~FourFourAIPlayer() override { stop_pondering(); }
+
     /**
      * @brief Create a dualMove at position (x, y) with stored direction.
      */
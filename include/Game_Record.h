@@ -0,0 +1,164 @@
+//
+// Created by abdelhamid on 12/20/25.
+//
+
+#ifndef BOARDGAMEFRAMEWORK_GAME_RECORD_H
+#define BOARDGAMEFRAMEWORK_GAME_RECORD_H
+
+#include "BoardGame_Classes.h"
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Move class used by a recorded game, which tells what each move's payload byte means.
+ */
+enum class RecordedMoveType : uint8_t {
+    PLAIN = 0,  ///< Move<char>: cell only.
+    NUMBER = 1, ///< nMove (Numerical X-O): the number played.
+    LETTER = 2, ///< neMove (Word X-O): the letter played.
+    SUS = 3,    ///< ne_Move (SUS): the letter played.
+    SLIDE = 4   ///< dualMove (Four Four X-O): the direction the piece moves.
+};
+
+/**
+ * @brief One move of a game record.
+ */
+struct RecordedMove {
+    uint8_t x = 0, y = 0; ///< Cell (for a slide, the cell the piece leaves).
+    char value = 0;       ///< Number or letter played (NUMBER, LETTER, SUS).
+    int8_t dx = 0, dy = 0; ///< Direction of a slide (SLIDE).
+    uint8_t placed = 0;   ///< Cells the board filled by itself after the move (Obstacles X-O).
+};
+
+/**
+ * @brief Cell and payload of a move.
+ * @param type Set to the move's class, left as is for a plain Move<char>.
+ */
+RecordedMove recorded_move(const Move<char>& move, RecordedMoveType& type);
+
+/** @brief Move class the game of this board expects. */
+RecordedMoveType recorded_move_type(const Board<char>& board);
+
+/**
+ * @brief A game as stored in a record file.
+ *
+ * Players move in turn, X (players[0]) first, so a move's symbol is given by
+ * its index. Cells a board fills by itself (the random obstacles of Obstacles
+ * X-O) are kept in placed_cells, in order, so that the game can be replayed.
+ */
+struct GameRecord {
+    /** @brief Values of result. */
+    enum Result : uint8_t { X_WINS = 0, O_WINS = 1, DRAW = 2, UNFINISHED = 3 };
+
+    static constexpr size_t MAX_NAME_LENGTH = 255;   ///< Longer names are cut when written.
+    static constexpr size_t MAX_MOVES_PER_CELL = 128; ///< Readers reject records with more moves per board cell.
+
+    uint32_t game_id = 0;            ///< Menu number of the game.
+    string players[2];               ///< Names of X and O.
+    uint8_t rows = 0, columns = 0;   ///< Board size.
+    RecordedMoveType move_type = RecordedMoveType::PLAIN;
+    uint8_t result = UNFINISHED;
+    vector<RecordedMove> moves;
+    vector<uint8_t> placed_cells;    ///< x * columns + y of each cell filled by the board.
+
+    /** @brief Symbol of the player who made move i. */
+    static char symbol(size_t i) { return i % 2 == 0 ? 'X' : 'O'; }
+
+    /** @brief Move i as the Move class the game's board expects (caller deletes it). */
+    Move<char>* make_move(size_t i) const { return make_move(move_type, moves[i], symbol(i)); }
+
+    /** @brief Move m of the given class played by symbol (caller deletes it). */
+    static Move<char>* make_move(RecordedMoveType type, const RecordedMove& m, char symbol);
+
+    /**
+     * @brief Play the recorded moves on a new board of the game.
+     * @return false if the board rejects a move.
+     */
+    bool replay(Board<char>& board) const;
+};
+
+/**
+ * @class GameRecordWriter
+ * @brief Appends game records to a file; several games (threads) can share one writer.
+ *
+ * File layout: the 8 byte magic "BGFGR001", then one record per game:
+ * game id (varint), the two names (varint length and bytes each), rows,
+ * columns, move type and result (1 byte each), move count (varint), then per
+ * move (cell x * columns + y) * 2 + 1 if the board filled cells after it, else
+ * + 0 (varint), unless the move type is PLAIN one payload byte (the value, or
+ * (dx + 1) * 3 + (dy + 1) for a slide), then if flagged the number of filled
+ * cells and the cells (varints). Varints are LEB128: 7 bits per byte, low bits
+ * first, high bit set on all bytes but the last. A 3x3 game takes under 30
+ * bytes.
+ */
+class GameRecordWriter {
+private:
+    ofstream out;
+    mutex lock;
+
+public:
+    /** @brief Open path for appending (the magic is written to a new or empty file). */
+    explicit GameRecordWriter(const string& path);
+
+    /** @brief Whether the file could be opened. */
+    bool is_open() const { return out.is_open(); }
+
+    /** @brief Append one record. */
+    void write(const GameRecord& record);
+
+    /** @brief Serialize one record (without the file magic). */
+    static void encode(const GameRecord& record, string& bytes);
+};
+
+/**
+ * @class GameRecordReader
+ * @brief Reads the records of a file one at a time, without loading the file.
+ */
+class GameRecordReader {
+private:
+    ifstream in;
+    bool valid = false;
+
+    bool read_varint(uint64_t& value);
+
+public:
+    /** @brief Open a file written by GameRecordWriter. */
+    explicit GameRecordReader(const string& path);
+
+    /** @brief Whether the file could be opened and starts with the magic. */
+    bool is_open() const { return valid; }
+
+    /**
+     * @brief Read the next record into record (its buffers are reused).
+     * @return false at the end of the file, or on a truncated or corrupt record
+     *         (lengths above the GameRecord limits, cells off the board).
+     */
+    bool next(GameRecord& record);
+};
+
+/**
+ * @class GameRecorder
+ * @brief MoveRecorder that builds the record of each game and hands it to a writer.
+ *
+ * One recorder per GameManager; the writer may be shared.
+ */
+class GameRecorder : public MoveRecorder<char> {
+private:
+    GameRecordWriter& writer;
+    GameRecord current;
+    const Board<char>* board = nullptr;
+
+public:
+    GameRecorder(GameRecordWriter& writer, uint32_t game_id) : writer(writer) { current.game_id = game_id; }
+
+    void start(const Board<char>& board, Player<char>* const players[2]) override;
+    void record(const Move<char>& move) override;
+    void finish(int winner, bool finished) override;
+};
+
+#endif //BOARDGAMEFRAMEWORK_GAME_RECORD_H
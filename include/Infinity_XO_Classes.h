@@ -10,8 +10,9 @@
 #ifndef XO_CLASSES_H
 #define XO_CLASSES_H
 
-#include <queue>
+#include <deque>
 #include "BoardGame_Classes.h"
+#include "BitBoard.h"
 using namespace std;
 
 /**
@@ -28,7 +29,8 @@ class Infinity_X_O_Board : public Board<char> {
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
     int counter;
-    queue<pair<int, int>> last_moves;
+    deque<pair<int, int>> last_moves; ///< Marks in play order; every third move removes the oldest.
+    BitBoard bits; ///< X/O masks mirrored from the board for fast line checks.
 
 public:
     /**
@@ -48,7 +50,14 @@ public:
      * @param player Pointer to the player being checked.
      * @return true if the player has a winning line, false otherwise.
      */
-    bool is_win(Player<char>* player);
+    bool is_win(Player<char>* player) { return is_win(player->get_symbol()); }
+
+    /**
+     * @brief Checks if the player using the given symbol has won the game.
+     * @param symbol Symbol of the player being checked.
+     * @return true if the player has a winning line, false otherwise.
+     */
+    bool is_win(char symbol);
 
     /**
      * @brief Checks if the given player has lost the game.
@@ -70,6 +79,15 @@ public:
      * @return true if the game has ended, false otherwise.
      */
     bool game_is_over(Player<char>* player);
+
+    /** @brief Independent copy of the board, used by multi-threaded searches. */
+    Board<char>* clone() const { return new Infinity_X_O_Board(*this); }
+
+    /** @brief Save the cells, move count and the queue of marks still to be removed (see Board::snapshot()). */
+    bool snapshot(BoardSnapshot& s) const;
+
+    /** @brief Return to a state saved by snapshot(). */
+    bool restore(const BoardSnapshot& s);
 };
 
 
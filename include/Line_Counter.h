@@ -0,0 +1,151 @@
+//
+// Created by abdelhamid on 12/16/25.
+//
+
+#ifndef BOARDGAMEFRAMEWORK_LINE_COUNTER_H
+#define BOARDGAMEFRAMEWORK_LINE_COUNTER_H
+
+#include <vector>
+#include <utility>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @class LineCounter
+ * @brief Incremental "k in a row" bookkeeping for boards larger than a bitboard line table.
+ *
+ * The counter knows every winning line of a board (a fixed list of cells, with
+ * an optional group such as its direction or length). Boards call place() /
+ * remove() from update_board(); each call only touches the lines through that
+ * cell and keeps, per side, the number of lines the side fully owns. Win queries
+ * are then a counter lookup instead of a scan of the whole grid.
+ *
+ * Sides are 0 and 1 (see BitBoard::xo_side()).
+ */
+class LineCounter {
+private:
+    int columns = 0;
+    vector<vector<int>> cell_lines; ///< Lines through each cell (index x * columns + y).
+    vector<int> line_length;        ///< Cells per line.
+    vector<int> line_group;         ///< Group of each line.
+    vector<int> owned[2];           ///< Cells of each line owned by each side.
+    vector<int> complete[2];        ///< Fully owned lines per group and side.
+    int total[2] = {0, 0};          ///< Fully owned lines per side.
+
+    void change(int x, int y, int side, int delta) {
+        for (int line : cell_lines[x * columns + y]) {
+            int before = owned[side][line];
+            owned[side][line] += delta;
+            if (before == line_length[line] || owned[side][line] == line_length[line]) {
+                complete[side][line_group[line]] += delta;
+                total[side] += delta;
+            }
+        }
+    }
+
+public:
+    LineCounter() {}
+
+    /**
+     * @brief Construct an empty counter (no lines) for a rows x columns board.
+     */
+    LineCounter(int rows, int columns) : columns(columns), cell_lines(rows * columns) {}
+
+    /**
+     * @brief Register a line.
+     * @param cells Cells of the line as (x, y).
+     * @param group Group the line is counted in (>= 0).
+     * @return Index of the new line.
+     */
+    int add_line(const vector<pair<int, int>>& cells, int group = 0) {
+        int line = line_length.size();
+        for (auto& [x, y] : cells) cell_lines[x * columns + y].push_back(line);
+        line_length.push_back(cells.size());
+        line_group.push_back(group);
+        for (int side : {0, 1}) {
+            owned[side].push_back(0);
+            if ((int)complete[side].size() <= group) complete[side].resize(group + 1, 0);
+        }
+        return line;
+    }
+
+    /**
+     * @brief Register every run of `length` cells in direction (dx, dy).
+     * @param usable Optional filter, runs containing a cell it rejects are skipped.
+     */
+    void add_runs(int length, int dx, int dy, int group = 0, const function<bool(int, int)>& usable = nullptr) {
+        int rows = cell_lines.size() / columns;
+        for (int x = 0; x < rows; x++) {
+            for (int y = 0; y < columns; y++) {
+                int ex = x + (length - 1) * dx, ey = y + (length - 1) * dy;
+                if (ex < 0 || ex >= rows || ey < 0 || ey >= columns) continue;
+                vector<pair<int, int>> cells;
+                for (int k = 0; k < length; k++) {
+                    if (usable && !usable(x + k * dx, y + k * dy)) break;
+                    cells.push_back({x + k * dx, y + k * dy});
+                }
+                if ((int)cells.size() == length) add_line(cells, group);
+            }
+        }
+    }
+
+    /**
+     * @brief Register every run of `length` cells in all four directions (rows, columns, diagonals).
+     */
+    void add_all_runs(int length, int group = 0) {
+        add_runs(length, 0, 1, group);
+        add_runs(length, 1, 0, group);
+        add_runs(length, 1, 1, group);
+        add_runs(length, 1, -1, group);
+    }
+
+    /** @brief Record that side now owns cell (x, y). */
+    void place(int x, int y, int side) { change(x, y, side, +1); }
+
+    /** @brief Record that side no longer owns cell (x, y). */
+    void remove(int x, int y, int side) { change(x, y, side, -1); }
+
+    /** @brief Forget every placement (lines are kept). */
+    void reset() {
+        for (int side : {0, 1}) {
+            fill(owned[side].begin(), owned[side].end(), 0);
+            fill(complete[side].begin(), complete[side].end(), 0);
+            total[side] = 0;
+        }
+    }
+
+    /**
+     * @brief Forget every placement, then place every owned cell of a board (after a restore).
+     * @param side_of Side owning a cell value, -1 for none (e.g. BitBoard::xo_side).
+     */
+    template <typename Cells, typename SideOf>
+    void rebuild(const Cells& cells, SideOf side_of) {
+        reset();
+        for (int x = 0; x < (int)cells.size(); x++)
+            for (int y = 0; y < (int)cells[x].size(); y++) {
+                int side = side_of(cells[x][y]);
+                if (side >= 0) place(x, y, side);
+            }
+    }
+
+    /** @brief Whether side fully owns at least one line. */
+    bool has_line(int side) const { return side >= 0 && total[side] > 0; }
+
+    /** @brief Number of lines side fully owns. */
+    int complete_lines(int side) const { return total[side]; }
+
+    /** @brief Number of lines of the given group side fully owns. */
+    int complete_lines(int side, int group) const {
+        return group < (int)complete[side].size() ? complete[side][group] : 0;
+    }
+
+    /** @brief Indices of the lines through cell (x, y). */
+    const vector<int>& lines_through(int x, int y) const { return cell_lines[x * columns + y]; }
+
+    /** @brief Whether side owns every cell of the given line. */
+    bool line_complete(int line, int side) const { return owned[side][line] == line_length[line]; }
+};
+
+#endif //BOARDGAMEFRAMEWORK_LINE_COUNTER_H
@@ -12,6 +12,7 @@
 
 #include <bits/stdc++.h>
 #include "BoardGame_Classes.h"
+#include "BitBoard.h"
 using namespace std;
 
 /**
@@ -29,7 +30,7 @@ private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
     char took = '?'; ///< Character used to represent an empty cell on the board.
 
-    vector<vector<char>> hidden_board;
+    BitBoard hidden_board; ///< X/O masks of the hidden marks (the visible board stays blank).
 
 public:
     /**
@@ -49,7 +50,14 @@ public:
      * @param player Pointer to the player being checked.
      * @return true if the player has a winning line, false otherwise.
      */
-    bool is_win(Player<char>* player);
+    bool is_win(Player<char>* player) { return is_win(player->get_symbol()); }
+
+    /**
+     * @brief Checks if the player using the given symbol has won the game.
+     * @param symbol Symbol of the player being checked.
+     * @return true if the player has a winning line, false otherwise.
+     */
+    bool is_win(char symbol);
 
     /**
      * @brief Checks if the given player has lost the game.
@@ -71,6 +79,15 @@ public:
      * @return true if the game has  false otherwise.
      */
     bool game_is_over(Player<char>* player);
+
+    /** @brief Independent copy of the board, used by multi-threaded searches. */
+    Board<char>* clone() const { return new MEMORY_TIC_TAC_TOE_Board(*this); }
+
+    /** @brief Save the visible cells, move count and the hidden marks (see Board::snapshot()). */
+    bool snapshot(BoardSnapshot& s) const;
+
+    /** @brief Return to a state saved by snapshot(). */
+    bool restore(const BoardSnapshot& s);
 };
 
 
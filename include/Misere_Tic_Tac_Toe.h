@@ -13,6 +13,7 @@
 
 #include <bits/stdc++.h>
 #include "BoardGame_Classes.h"
+#include "BitBoard.h"
 #include "include/Smart_Player.h"
 
 
@@ -34,6 +35,7 @@ using namespace std;
 class Misere_Tic_Tac_Toe_board : public Board<char>{
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
+    BitBoard bits;           ///< X/O masks mirrored from the board for fast line checks.
 public:
     /**
  * @brief Default constructor that initializes a 3x3 X-O board.
@@ -55,6 +57,18 @@ public:
      */
     bool is_win(Player<char>*){return  false; };
 
+    /**
+     * @brief Checks if the player using the given symbol has won the game.
+     * @return Always returns false (players can only lose in Misere).
+     */
+    bool is_win(char){return  false; };
+
+    /**
+     * @brief The winner is the player who did not complete a line.
+     * @return 'X' or 'O', or 0 if nobody has completed a line yet.
+     */
+    char winner();
+
     /**
      * @brief Checks if the given player has lost the game.
      * @param player Pointer to the player being checked.
@@ -75,6 +89,15 @@ public:
      * @return true if the game has ended, false otherwise.
      */
     bool game_is_over(Player<char>* player);
+
+    /** @brief Independent copy of the board, used by multi-threaded searches. */
+    Board<char>* clone() const { return new Misere_Tic_Tac_Toe_board(*this); }
+
+    /** @brief Save the cells, move count and bitboard (see Board::snapshot()). */
+    bool snapshot(BoardSnapshot& s) const;
+
+    /** @brief Return to a state saved by snapshot(). */
+    bool restore(const BoardSnapshot& s);
 };
 
 /**
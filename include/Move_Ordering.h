@@ -0,0 +1,105 @@
+//
+// Created by abdelhamid on 12/23/25.
+//
+
+#ifndef BOARDGAMEFRAMEWORK_MOVE_ORDERING_H
+#define BOARDGAMEFRAMEWORK_MOVE_ORDERING_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class MoveOrdering
+ * @brief Order in which a minimax node tries its moves.
+ *
+ * Moves are small integers chosen by the game (usually x * columns + y). A
+ * node tries, in this order:
+ * - the table move (best move stored for the position), if the search has one;
+ * - the two killer moves of its depth: the last moves that caused a cutoff at
+ *   the same remaining depth elsewhere in the tree, since siblings are often
+ *   refuted the same way;
+ * - the others by history (depth^2 summed over the cutoffs each move caused
+ *   in this search) plus the game's static prior, e.g. centre cells first.
+ *
+ * Killers and history are per thread: a search calls for_search() on each of
+ * its threads and gets that thread's tables, cleared when they last served
+ * another search. Iterative deepening keeps them from one iteration to the next.
+ */
+class MoveOrdering {
+public:
+    static constexpr int MAX_DEPTH = 64;  ///< Killers are kept for remaining depths below this.
+    static constexpr int MAX_MOVES = 128; ///< Most moves order() sorts at once.
+    static constexpr int PRIOR_SCALE = 4; ///< History units per point of prior.
+
+private:
+    uint64_t search = 0;        ///< Search the tables belong to (0 = none).
+    vector<int> prior;          ///< Static score of every move.
+    vector<int> history;        ///< Cutoff score of every move.
+    int killers[MAX_DEPTH][2];  ///< Last two cutoff moves per remaining depth (-1 = none).
+
+    void reset(uint64_t s, const vector<int>& p) {
+        search = s;
+        prior = p;
+        history.assign(p.size(), 0);
+        for (auto& k : killers) k[0] = k[1] = -1;
+    }
+
+public:
+    MoveOrdering() { reset(0, {}); }
+
+    /** @brief Id for a new search (never 0). */
+    static uint64_t new_search() {
+        static atomic<uint64_t> next{0};
+        return ++next;
+    }
+
+    /**
+     * @brief Tables of the calling thread for the given search.
+     * @param search Id from new_search(), shared by all threads of the search.
+     * @param prior Static score of every move; its size is the number of moves.
+     */
+    static MoveOrdering& for_search(uint64_t search, const vector<int>& prior) {
+        static thread_local MoveOrdering ordering;
+        if (ordering.search != search) ordering.reset(search, prior);
+        return ordering;
+    }
+
+    /**
+     * @brief Sort moves[0..n) (n <= MAX_MOVES) best first for a node at the given remaining depth.
+     * @param table_move Move to try first, -1 if none. Equal moves keep their order.
+     */
+    void order(int moves[], int n, int depth, int table_move = -1) const {
+        const int* killer = depth < MAX_DEPTH ? killers[depth] : nullptr;
+        int keys[MAX_MOVES];
+        for (int k = 0; k < n; k++) {
+            int m = moves[k];
+            int key;
+            if (m == table_move) key = 1 << 30;
+            else if (killer && m == killer[0]) key = (1 << 30) - 1;
+            else if (killer && m == killer[1]) key = (1 << 30) - 2;
+            else key = history[m] + prior[m] * PRIOR_SCALE;
+            // insertion sort, stable
+            int i = k;
+            for (; i > 0 && keys[i - 1] < key; i--) {
+                keys[i] = keys[i - 1];
+                moves[i] = moves[i - 1];
+            }
+            keys[i] = key;
+            moves[i] = m;
+        }
+    }
+
+    /** @brief Record that move caused a cutoff at the given remaining depth. */
+    void cutoff(int move, int depth) {
+        if (depth < MAX_DEPTH && killers[depth][0] != move) {
+            killers[depth][1] = killers[depth][0];
+            killers[depth][0] = move;
+        }
+        if (history[move] < (1 << 29)) history[move] += depth * depth;
+    }
+};
+
+#endif //BOARDGAMEFRAMEWORK_MOVE_ORDERING_H
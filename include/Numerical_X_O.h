@@ -1,4 +1,5 @@
 #include "BoardGame_Classes.h"
+#include <cstdint>
 using namespace std;
 
 #ifndef NUMERICAL_X_O_H
@@ -9,6 +10,10 @@ class Numerical_X_O_Board : public Board<char> {
 private:
     char blank_symbol = '0';
     int counter;
+    int line_sum[8] = {0};  // sum of each row, column and diagonal (blank counts as 0)
+    int lines_at_15 = 0;    // lines whose sum is 15
+    char last_symbol = 0;   // player who made the last move, the one a sum of 15 credits
+    uint16_t digits[2] = {0x155, 0x0AA}; // numbers X (odd) and O (even) have left, bit d - 1 for digit d
 
 public:
     Numerical_X_O_Board();
@@ -16,7 +21,9 @@ public:
     bool update_board(Move<char>* move);
 
 
-    bool is_win(Player<char>* player);
+    bool is_win(Player<char>* player) { return is_win(player->get_symbol()); }
+
+    bool is_win(char symbol);
 
 
     bool is_lose(Player<char>*) { return false; };
@@ -27,6 +34,17 @@ public:
 
     bool game_is_over(Player<char>* player);
 
+    // Numbers the player with this symbol has left, bit d - 1 for digit d (0 for other symbols)
+    uint16_t available_digits(char symbol) const;
+
+    Board<char>* clone() const { return new Numerical_X_O_Board(*this); }
+
+    // Save the cells, move count, line sums and numbers left (see Board::snapshot())
+    bool snapshot(BoardSnapshot& s) const;
+
+    // Return to a state saved by snapshot()
+    bool restore(const BoardSnapshot& s);
+
     virtual ~Numerical_X_O_Board() {}
 };
 
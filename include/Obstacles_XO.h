@@ -7,10 +7,18 @@
 #define BOARDGAMEFRAMEWORK_OBSTACLES_XO_H
 
 #include "BoardGame_Classes.h"
+#include "BitBoard.h"
+#include "Line_Counter.h"
+#include <deque>
+#include <utility>
+#include <vector>
 
 class Obstacles_XO_Board : public Board<char> {
 private:
     char obstacle_symbol = '#'; /// Symbol for the obstacles
+    LineCounter lines;          /// Every run of 4 cells, updated on each placement
+    vector<pair<int, int>> obstacles; /// Obstacles in the order they were placed
+    deque<pair<int, int>> queued;     /// Cells used for the next obstacles instead of random ones
 
 public:
 
@@ -32,7 +40,14 @@ public:
      * @param player Pointer to the player being checked.
      * @return true if the player has a winning line, false otherwise.
      */
-    bool is_win(Player<char>* player);
+    bool is_win(Player<char>* player) { return is_win(player->get_symbol()); }
+
+    /**
+     * @brief Checks if the player using the given symbol has won the game.
+     * @param symbol Symbol of the player being checked.
+     * @return true if the player has a winning line, false otherwise.
+     */
+    bool is_win(char symbol);
 
     /**
      * @brief Checks if the given player has lost the game.
@@ -56,6 +71,25 @@ public:
 
     bool game_is_over(Player<char>* player);
 
+    /** @brief Obstacles placed so far, in order (game records store them). */
+    const vector<pair<int, int>>& get_obstacles() const { return obstacles; }
+
+    /**
+     * @brief Place the next obstacle at (x, y) instead of a random cell (to replay a recorded game).
+     *
+     * Queued cells are used in order; a queued cell that is not empty is skipped.
+     */
+    void queue_obstacle(int x, int y) { queued.emplace_back(x, y); }
+
+    /** @brief Independent copy of the board, used by multi-threaded searches. */
+    Board<char>* clone() const { return new Obstacles_XO_Board(*this); }
+
+    /** @brief Save the cells, move count and obstacle order; the line counts are rebuilt on restore (see Board::snapshot()). */
+    bool snapshot(BoardSnapshot& s) const;
+
+    /** @brief Return to a state saved by snapshot(). */
+    bool restore(const BoardSnapshot& s);
+
     virtual ~Obstacles_XO_Board() {};
 };
 
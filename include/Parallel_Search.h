@@ -0,0 +1,115 @@
+//
+// Created by abdelhamid on 12/15/25.
+//
+
+#ifndef BOARDGAMEFRAMEWORK_PARALLEL_SEARCH_H
+#define BOARDGAMEFRAMEWORK_PARALLEL_SEARCH_H
+
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Resolve a requested worker count (0 = one per hardware thread, at least 1).
+ */
+inline int resolve_search_threads(int requested) {
+    if (requested > 0) return requested;
+    unsigned hw = thread::hardware_concurrency();
+    return hw ? static_cast<int>(hw) : 1;
+}
+
+/**
+ * @class RootBest
+ * @brief Best root move found so far, shared by the workers of a root split search.
+ *
+ * The score doubles as the alpha bound every worker reads before searching its
+ * next root move. A result is only accepted if it beats that score; on equal
+ * scores the lower root index wins, provided the result is exact (it was above
+ * the alpha it was searched with), so the choice does not depend on timing.
+ */
+class RootBest {
+private:
+    atomic<int> score{numeric_limits<int>::min()};
+    int index = -1;
+    mutable mutex lock;
+
+public:
+    /** @brief Current best score, to be used as the root alpha. */
+    int alpha() const { return score.load(memory_order_relaxed); }
+
+    /** @brief Root index of the best move, -1 if none was accepted. */
+    int best_index() const {
+        lock_guard<mutex> guard(lock);
+        return index;
+    }
+
+    /**
+     * @brief Offer the result of root move k.
+     * @param k Root move index.
+     * @param value Score returned by the search.
+     * @param searched_alpha Alpha the move was searched with.
+     */
+    void offer(int k, int value, int searched_alpha) {
+        lock_guard<mutex> guard(lock);
+        int current = score.load(memory_order_relaxed);
+        if (value > current || (value == current && value > searched_alpha && k < index)) {
+            score.store(value, memory_order_relaxed);
+            index = k;
+        }
+    }
+};
+
+/**
+ * @brief Run fn(worker, k) for every root move k in [0, count) on up to `threads` workers.
+ *
+ * Workers pull the next index from a shared counter, so a slow subtree does not
+ * hold back the others. Worker 0 is the calling thread; workers 1.. are started
+ * here and joined before returning. Each worker id is used by exactly one thread,
+ * so callers can index per-worker state (board clones, tables) by it.
+ */
+template<typename Fn>
+void run_root_split(int count, int threads, Fn fn) {
+    if (count <= 0) return;
+    if (threads > count) threads = count;
+    if (threads <= 1) {
+        for (int k = 0; k < count; k++) fn(0, k);
+        return;
+    }
+
+    atomic<int> next{0};
+    auto work = [&](int worker) {
+        for (int k = next.fetch_add(1); k < count; k = next.fetch_add(1))
+            fn(worker, k);
+    };
+
+    vector<thread> pool;
+    for (int w = 1; w < threads; w++) pool.emplace_back(work, w);
+    work(0);
+    for (auto& t : pool) t.join();
+}
+
+/**
+ * @brief Lazy SMP: run main() on the calling thread and helper(worker) on workers 1..threads-1.
+ *
+ * Every thread searches the whole tree from the same root; helpers vary their
+ * depths or move order by worker id so they do not all walk the same path, and
+ * share what they find only through a common lock-free transposition table,
+ * where the main thread picks it up as cutoffs and table moves. Once main()
+ * returns, stop_helpers is set (helpers must poll it and give up) and the
+ * helpers are joined. The result is main()'s: helpers never decide the move.
+ */
+template<typename Main, typename Helper>
+auto run_lazy_smp(int threads, atomic<bool>& stop_helpers, Main main, Helper helper) {
+    vector<thread> pool;
+    for (int w = 1; w < threads; w++) pool.emplace_back(helper, w);
+    auto result = main();
+    stop_helpers = true;
+    for (auto& t : pool) t.join();
+    return result;
+}
+
+#endif //BOARDGAMEFRAMEWORK_PARALLEL_SEARCH_H
@@ -6,11 +6,13 @@
 #define BOARDGAMEFRAMEWORK_PYRAMID_XO_H
 
 #include "BoardGame_Classes.h"
+#include "BitBoard.h"
 #include "Smart_Player.h"
 
 class Pyramid_XO_Board : public Board<char> {
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
+    BitBoard bits{5};        ///< X/O masks mirrored from the 3x5 board for fast line checks.
 
 public:
     /**
@@ -30,7 +32,14 @@ public:
      * @param player Pointer to the player being checked.
      * @return true if the player has a winning line, false otherwise.
      */
-    bool is_win(Player<char>* player);
+    bool is_win(Player<char>* player) { return is_win(player->get_symbol()); }
+
+    /**
+     * @brief Checks if the player using the given symbol has won the game.
+     * @param symbol Symbol of the player being checked.
+     * @return true if the player has a winning line, false otherwise.
+     */
+    bool is_win(char symbol);
 
     /**
      * @brief Checks if the given player has lost the game.
@@ -53,6 +62,15 @@ public:
      */
     bool game_is_over(Player<char>* player);
 
+    /** @brief Independent copy of the board, used by multi-threaded searches. */
+    Board<char>* clone() const { return new Pyramid_XO_Board(*this); }
+
+    /** @brief Save the cells, move count and bitboard (see Board::snapshot()). */
+    bool snapshot(BoardSnapshot& s) const;
+
+    /** @brief Return to a state saved by snapshot(). */
+    bool restore(const BoardSnapshot& s);
+
     virtual ~Pyramid_XO_Board(){};
 };
 
@@ -10,6 +10,7 @@
 #define SUS_CLASSES_H
 
 #include "BoardGame_Classes.h"
+#include "BitBoard.h"
 #include <string>
 
 using namespace std ;
@@ -28,6 +29,8 @@ using namespace std ;
 class SUS_Board : public Board<char> {
 private:
     char blank_symbol = '.';
+    BitBoard bits; ///< 'S' (side 0) and 'U' (side 1) masks mirrored from the board.
+    char last_symbol = 0; ///< Player who made the last move.
 
 public:
 
@@ -49,7 +52,14 @@ public:
     * @param player Pointer to the player being checked.
     * @return true if the player has a winning line, false otherwise.
     */
-    bool is_win(Player<char>* player);
+    bool is_win(Player<char>* player) { return is_win(player->get_symbol()); }
+
+    /**
+     * @brief Checks if the player using the given symbol has won the game.
+     * @param symbol Symbol of the player being checked.
+     * @return true if the player just completed an odd number of S-U-S lines, false otherwise.
+     */
+    bool is_win(char symbol);
     /**
      * @brief Checks if the given player has lost the game.
      * @param player Pointer to the player being checked.
@@ -71,6 +81,15 @@ public:
      */
     bool game_is_over(Player<char>* player);
 
+    /** @brief Independent copy of the board, used by multi-threaded searches. */
+    Board<char>* clone() const { return new SUS_Board(*this); }
+
+    /** @brief Save the cells, move count, bitboard and last mover (see Board::snapshot()). */
+    bool snapshot(BoardSnapshot& s) const;
+
+    /** @brief Return to a state saved by snapshot(). */
+    bool restore(const BoardSnapshot& s);
+
 };
 
 /**
@@ -0,0 +1,158 @@
+//
+// Created by abdelhamid on 12/21/25.
+//
+
+#ifndef BOARDGAMEFRAMEWORK_SEARCH_STATS_H
+#define BOARDGAMEFRAMEWORK_SEARCH_STATS_H
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+using namespace std;
+
+/**
+ * @brief What a search did, counted by the thread that did it.
+ *
+ * Search functions count into thread_search_counters(); the driver of a
+ * search adds up what each of its threads counted with count_search().
+ */
+struct SearchCounters {
+    static constexpr int CUTOFF_SLOTS = 8; ///< Move indexes told apart in cutoffs.
+
+    uint64_t nodes = 0;     ///< Positions visited (calls of the search function).
+    uint64_t leaves = 0;    ///< Heuristic evaluations at the depth limit.
+    uint64_t cutoffs[CUTOFF_SLOTS] = {}; ///< Beta cutoffs by index of the move that caused them (last slot: that index or later).
+    uint64_t tt_probes = 0; ///< Transposition table lookups.
+    uint64_t tt_hits = 0;   ///< Lookups that found the position.
+
+    /** @brief Count a cutoff caused by the index-th move tried (0 = first). */
+    void cutoff(int index) {
+        cutoffs[index < CUTOFF_SLOTS ? index : CUTOFF_SLOTS - 1]++;
+    }
+
+    /** @brief Add what was counted between before and after (two readings of one thread's counters). */
+    void add_delta(const SearchCounters& after, const SearchCounters& before) {
+        nodes += after.nodes - before.nodes;
+        leaves += after.leaves - before.leaves;
+        for (int i = 0; i < CUTOFF_SLOTS; i++) cutoffs[i] += after.cutoffs[i] - before.cutoffs[i];
+        tt_probes += after.tt_probes - before.tt_probes;
+        tt_hits += after.tt_hits - before.tt_hits;
+    }
+
+    /** @brief Add the counts of another search. */
+    void add(const SearchCounters& o) {
+        add_delta(o, SearchCounters());
+    }
+};
+
+/**
+ * @brief Counters of the calling thread; they only grow, read them before and after.
+ */
+inline SearchCounters& thread_search_counters() {
+    static thread_local SearchCounters counters;
+    return counters;
+}
+
+/**
+ * @brief Run search() on this thread and add what it counted to total.
+ * @return What search() returned.
+ */
+template<typename Fn>
+auto count_search(SearchCounters& total, Fn search) {
+    SearchCounters before = thread_search_counters();
+    auto result = search();
+    total.add_delta(thread_search_counters(), before);
+    return result;
+}
+
+/**
+ * @brief Statistics of the search behind one move.
+ */
+struct SearchStats {
+    string game;              ///< Game the player plays, empty if not set.
+    string player;            ///< Name of the player.
+    int move = 0;             ///< Moves the player has searched in this game, this one included.
+    int depth = 0;            ///< Plies searched from the root (deepest completed iteration).
+    SearchCounters counters;
+    uint64_t elapsed_ns = 0;  ///< Wall-clock time of the move.
+    bool pondered = false;    ///< Answered from a search done on the opponent's time.
+    uint64_t ponder_nodes = 0; ///< Nodes searched while pondering since the previous move.
+    uint64_t ponder_ns = 0;    ///< Time spent pondering since the previous move.
+
+    /** @brief Nodes per second of the move's own search. */
+    double nps() const { return elapsed_ns ? counters.nodes * 1e9 / elapsed_ns : 0.0; }
+
+    /**
+     * @brief One JSON object on one line, e.g.
+     * {"game":"Four-in-a-row","player":"A","move":3,"depth":9,"nodes":51234,...}
+     */
+    string to_json() const;
+};
+
+/**
+ * @class SearchStatsSink
+ * @brief Receives the statistics of every move searched by the players attached to it.
+ *
+ * Players of games running on several threads may share a sink, so report()
+ * must be thread safe.
+ */
+class SearchStatsSink {
+public:
+    virtual ~SearchStatsSink() {}
+
+    virtual void report(const SearchStats& stats) = 0;
+};
+
+/**
+ * @class SearchStatsFile
+ * @brief Appends one JSON line per move to a file.
+ */
+class SearchStatsFile : public SearchStatsSink {
+private:
+    ofstream out;
+    mutex lock;
+
+public:
+    /** @brief Open path for appending. */
+    explicit SearchStatsFile(const string& path) : out(path, ios::app) {}
+
+    /** @brief Whether the file could be opened. */
+    bool is_open() const { return out.is_open(); }
+
+    void report(const SearchStats& stats) override;
+};
+
+/**
+ * @class SearchStatsReporter
+ * @brief The statistics side of a search engine: last move's statistics and the sink they go to.
+ */
+class SearchStatsReporter {
+private:
+    SearchStatsSink* sink = nullptr;
+    string game;
+    int moves = 0;
+    SearchStats last;
+
+public:
+    /** @brief Send the statistics of the following moves to sink (nullptr to stop), labelled with game. */
+    void attach(SearchStatsSink* s, const string& game_name) {
+        sink = s;
+        game = game_name;
+    }
+
+    /** @brief Keep the statistics of the move just searched and send them to the sink. */
+    void report(const SearchStats& stats, const string& player) {
+        last = stats;
+        last.game = game;
+        last.player = player;
+        last.move = ++moves;
+        if (sink) sink->report(last);
+    }
+
+    /** @brief Statistics of the last move searched. */
+    const SearchStats& get_last() const { return last; }
+};
+
+#endif //BOARDGAMEFRAMEWORK_SEARCH_STATS_H
@@ -6,14 +6,97 @@
 #define BOARDGAMEFRAMEWORK_SMART_PLAYER_H
 
 #include "BoardGame_Classes.h"
+#include "Parallel_Search.h"
+#include "Search_Stats.h"
+#include "Move_Ordering.h"
 #include <limits>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <thread>
 
 using namespace std;
 
 template <typename T>
 class smartPlayer : public Player<T> {
 protected:
+    // Iterative deepening settings: search depth 0, 1, 2... until the time budget expires
+    int time_budget_ms = 1000;   // wall-clock budget per move
+    int max_search_depth = 64;   // hard cap on the deepest iteration
+    chrono::steady_clock::time_point deadline;
+    atomic<bool> search_aborted{false}; // set once the deadline passes, the running iteration is discarded
+
+    // Root split: root moves are searched on this many threads (0 = one per hardware thread).
+    // minimax and the evaluation hooks then run concurrently, each thread on its own board copy.
+    int search_threads = 1;
+
+    // Pondering: after each move a background thread searches the positions the opponent can
+    // reach, so calculateMove answers at once if the opponent plays one of them
+    bool ponder_enabled = false;
+    thread ponder_thread;
+    atomic<bool> ponder_stop{false};               // aborts the pondering search like the deadline
+    map<vector<vector<T>>, pair<int,int>> pondered; // best move of each position searched while pondering
+
+    // Statistics: search_best_move leaves its counts here, calculateMove reports them per move
+    SearchStatsReporter stats;
+    SearchCounters search_counts;      // all threads of the last search_best_move
+    int search_plies = 0;              // plies of its deepest completed iteration
+    uint64_t ponder_nodes = 0, ponder_ns = 0; // pondering since the last move
+
+    // Move ordering inside minimax (see MoveOrdering): set up by search_best_move for all its threads
+    uint64_t ordering_search = 0; // id of the running search
+    vector<int> move_priors;      // move_prior() of every cell, index x * columns + y
+
+    static uint64_t elapsed_ns(chrono::steady_clock::time_point begin) {
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - begin).count();
+    }
+
+    void start_search_clock() {
+        deadline = chrono::steady_clock::now() + chrono::milliseconds(time_budget_ms);
+        search_aborted = false;
+    }
+
+    // Cheap enough to call at every node: only reads the clock every 256 calls (per thread)
+    bool time_up() {
+        static thread_local unsigned long clock_checks = 0;
+        if (search_aborted) return true;
+        if ((++clock_checks & 255) == 0 && (ponder_stop || chrono::steady_clock::now() >= deadline))
+            search_aborted = true;
+        return search_aborted;
+    }
+
+    // Length of the winning sequence, passed as N to is_win / evaluate_board / minimax
+    virtual int win_length() const { return 3; }
+
+    // Static preference for playing (x, y), the tie-break of the move ordering (default: closer to the centre)
+    virtual int move_prior(int x, int y, int rows, int cols) const {
+        return rows + cols - abs(2 * x - (rows - 1)) - abs(2 * y - (cols - 1));
+    }
+
+    // Killers and history of the calling thread for the running search
+    MoveOrdering& move_ordering() { return MoveOrdering::for_search(ordering_search, move_priors); }
+
+    // Set up the move ordering of a new search on b
+    void start_move_ordering(const vector<vector<T>>& b) {
+        int rows = b.size();
+        int cols = b[0].size();
+        move_priors.resize(rows * cols);
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < cols; j++) move_priors[i * cols + j] = move_prior(i, j, rows, cols);
+        ordering_search = MoveOrdering::new_search();
+    }
+
+    // Root moves for the side to move (default: every empty cell)
+    virtual vector<pair<int,int>> generate_moves(const vector<vector<T>>& b) const {
+        vector<pair<int,int>> moves;
+        for (int i = 0; i < (int)b.size(); i++)
+            for (int j = 0; j < (int)b[i].size(); j++)
+                if (b[i][j] == '.') moves.push_back({i, j});
+        return moves;
+    }
+
     // Virtual so derived games can override for custom symbols
     virtual T get_opponent_symbol() const {
         // This is default X-O symbols
@@ -110,82 +193,226 @@ protected:
     // Minmax Alg with alpha bata optimization and depth optimization to avoid excessive search for large boards
     // https://www.geeksforgeeks.org/dsa/minimax-algorithm-in-game-theory-set-4-alpha-beta-pruning/
     virtual int minimax(vector<vector<T>>& b, bool maximizingPlayer, T ai, T opp, int alpha, int beta, int depth, int N = 3) {
+        if (time_up()) return 0; // result is thrown away with the aborted iteration
+        SearchCounters& counters = thread_search_counters();
+        counters.nodes++;
         if (is_win(b, ai, N)) return 1000 + depth; // prefer faster win
         if (is_win(b, opp, N)) return -1000 - depth; // prefer slower loss
         if (is_draw(b, N)) return 0;
-        if (depth == 0) return evaluate_board(b, ai, opp, N);
+        if (depth == 0) {
+            counters.leaves++;
+            return evaluate_board(b, ai, opp, N);
+        }
 
         int rows = b.size();
         int cols = b[0].size();
+        int moves[MoveOrdering::MAX_MOVES];
+        int n = 0;
+        for (int i = 0; i < rows; i++)
+            for (int j = 0; j < cols && n < MoveOrdering::MAX_MOVES; j++)
+                if (b[i][j] == '.') moves[n++] = i * cols + j;
+        MoveOrdering& ordering = move_ordering();
+        ordering.order(moves, n, depth);
 
-        if (maximizingPlayer) {
-            int best = numeric_limits<int>::min();
-            for (int i = 0; i < rows; i++)
-                for (int j = 0; j < cols; j++)
-                    if (b[i][j] == '.') {
-                        b[i][j] = ai;
-                        int val = minimax(b, false, ai, opp, alpha, beta, depth - 1, N);
-                        b[i][j] = '.';
-                        best = max(best, val);
-                        alpha = max(alpha, best);
-                        if (beta <= alpha) return best;
-                    }
-            return best;
-        } else {
-            int best = numeric_limits<int>::max();
-            for (int i = 0; i < rows; i++)
-                for (int j = 0; j < cols; j++)
-                    if (b[i][j] == '.') {
-                        b[i][j] = opp;
-                        int val = minimax(b, true, ai, opp, alpha, beta, depth - 1, N);
-                        b[i][j] = '.';
-                        best = min(best, val);
-                        beta = min(beta, best);
-                        if (beta <= alpha) return best;
-                    }
-            return best;
+        int best = maximizingPlayer ? numeric_limits<int>::min() : numeric_limits<int>::max();
+        for (int k = 0; k < n; k++) {
+            int i = moves[k] / cols, j = moves[k] % cols;
+            b[i][j] = maximizingPlayer ? ai : opp;
+            int val = minimax(b, !maximizingPlayer, ai, opp, alpha, beta, depth - 1, N);
+            b[i][j] = '.';
+            if (maximizingPlayer) {
+                best = max(best, val);
+                alpha = max(alpha, best);
+            } else {
+                best = min(best, val);
+                beta = min(beta, best);
+            }
+            if (beta <= alpha) {
+                counters.cutoff(k);
+                ordering.cutoff(moves[k], depth);
+                return best;
+            }
+        }
+        return best;
+    }
+
+    // Iterative deepening driver: returns the best move of the last completed iteration.
+    // Root moves are re-ordered after each iteration by their scores, so the previous
+    // principal variation move is searched first and sets a tight alpha for the rest.
+    // That first move is searched alone; the others are split across search_threads workers
+    // that share the best score so far as their alpha. Leaves its statistics in search_counts.
+    // Games with an engine of their own override it (same deadline, same statistics).
+    virtual pair<int,int> search_best_move(vector<vector<T>>& b) {
+        T ai = this->get_symbol();
+        T opp = get_opponent_symbol();
+        int N = win_length();
+        search_counts = SearchCounters();
+        search_plies = 0;
+
+        vector<pair<int,int>> moves = generate_moves(b);
+        if (moves.empty()) return {-1, -1};
+
+        int empties = 0;
+        for (auto& row : b)
+            for (auto& cell : row)
+                if (cell == '.') empties++;
+
+        start_search_clock();
+        start_move_ordering(b);
+        pair<int,int> best = moves[0];
+        vector<int> scores(moves.size());
+
+        int threads = resolve_search_threads(search_threads);
+        vector<vector<vector<T>>> boards(threads, b); // one private copy per worker
+        vector<SearchCounters> counted(threads);        // and its statistics
+
+        for (int depth = 0; depth < max_search_depth; depth++) {
+            RootBest rootBest;
+
+            auto search_root = [&](int worker, int k) {
+                vector<vector<T>>& wb = boards[worker];
+                int alpha = rootBest.alpha();
+                auto [i, j] = moves[k];
+                wb[i][j] = ai;
+                scores[k] = count_search(counted[worker], [&] {
+                    return minimax(wb, false, ai, opp,
+                                   alpha,
+                                   numeric_limits<int>::max(),
+                                   depth, N);
+                });
+                wb[i][j] = '.';
+                if (!search_aborted) rootBest.offer(k, scores[k], alpha);
+            };
+
+            search_root(0, 0);
+            run_root_split((int)moves.size() - 1, threads, [&](int worker, int k) {
+                if (!search_aborted) search_root(worker, k + 1);
+            });
+            if (search_aborted) break;
+            search_plies = depth + 1;
+
+            int bestVal = rootBest.alpha();
+            if (rootBest.best_index() >= 0) best = moves[rootBest.best_index()];
+
+            // Stop early once a win is proven (1000 + remaining depth) or every remaining ply was searched
+            if ((bestVal >= 1000 && bestVal <= 1000 + depth) || depth + 1 >= empties) break;
+
+            vector<size_t> order(moves.size());
+            for (size_t k = 0; k < order.size(); k++) order[k] = k;
+            stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) { return scores[x] > scores[y]; });
+            vector<pair<int,int>> sorted;
+            for (size_t k : order) sorted.push_back(moves[k]);
+            moves = sorted;
+        }
+
+        for (auto& c : counted) search_counts.add(c);
+        return best;
+    }
+
+    // Body of the pondering thread, b is the position after the AI's move. Each reply gets the
+    // search calculateMove would run, most likely replies (best for the opponent at one ply) first.
+    void ponder(vector<vector<T>> b) {
+        T ai = this->get_symbol();
+        T opp = get_opponent_symbol();
+        int N = win_length();
+        if (is_win(b, ai, N) || is_draw(b, N)) return;
+
+        vector<pair<int,int>> replies = generate_moves(b);
+        vector<int> scores;
+        for (auto [i, j] : replies) {
+            b[i][j] = opp;
+            scores.push_back(evaluate_board(b, opp, ai, N));
+            b[i][j] = '.';
+        }
+        vector<size_t> order(replies.size());
+        for (size_t k = 0; k < order.size(); k++) order[k] = k;
+        stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) { return scores[x] > scores[y]; });
+
+        for (size_t k : order) {
+            auto [i, j] = replies[k];
+            b[i][j] = opp;
+            if (!is_win(b, opp, N) && !is_draw(b, N)) {
+                auto begin = chrono::steady_clock::now();
+                pair<int,int> best = search_best_move(b);
+                ponder_nodes += search_counts.nodes;
+                ponder_ns += elapsed_ns(begin);
+                if (ponder_stop) return; // unfinished search, thrown away
+                pondered[b] = best;
+            }
+            b[i][j] = '.';
         }
     }
 
 public:
     smartPlayer(string n, T s, PlayerType t) : Player<T>(n, s, t) {}
 
+    // Per-move wall-clock budget used by calculateMove
+    void set_time_budget(int ms) { time_budget_ms = ms; }
+    int get_time_budget() const { return time_budget_ms; }
+
+    // Deepest iteration calculateMove may reach
+    void set_max_depth(int depth) { max_search_depth = depth; }
+
+    // Threads used to search root moves in parallel (0 = one per hardware thread)
+    void set_search_threads(int threads) { search_threads = threads; }
+
+    // Send the statistics of every calculateMove to sink (nullptr to stop), labelled with game
+    void set_stats_sink(SearchStatsSink* sink, const string& game) { stats.attach(sink, game); }
+
+    // Statistics of the last calculateMove
+    const SearchStats& last_search_stats() const { return stats.get_last(); }
+
+    // Search on the opponent's time after each calculateMove (off by default)
+    void set_pondering(bool on) {
+        ponder_enabled = on;
+        if (!on) stop_pondering();
+    }
+
+    // Abort the pondering search, if any, and wait for its thread
+    void stop_pondering() override {
+        if (!ponder_thread.joinable()) return;
+        ponder_stop = true;
+        ponder_thread.join();
+        ponder_stop = false;
+    }
+
     virtual pair<int,int> calculateMove()  {
         Board<T>* board_ptr = this->get_board_ptr();
         if (!board_ptr) throw runtime_error("Board not assigned to player!");
 
+        stop_pondering();
+        auto begin = chrono::steady_clock::now();
         auto tempBoard = board_ptr->get_board_matrix();
-        int rows = tempBoard.size();
-        int cols = tempBoard[0].size();
-
-        int bestVal = numeric_limits<int>::min();
-        int bestX = -1, bestY = -1;
+        SearchStats move_stats;
+        // A position searched while pondering is answered without searching again
+        auto it = pondered.find(tempBoard);
+        pair<int,int> best;
+        if (it != pondered.end()) {
+            best = it->second;
+            move_stats.pondered = true;
+        } else {
+            best = search_best_move(tempBoard);
+            move_stats.counters = search_counts;
+            move_stats.depth = search_plies;
+        }
+        pondered.clear();
 
-        T ai = this->get_symbol();
-        T opp = get_opponent_symbol();
+        move_stats.elapsed_ns = elapsed_ns(begin);
+        move_stats.ponder_nodes = ponder_nodes;
+        move_stats.ponder_ns = ponder_ns;
+        ponder_nodes = ponder_ns = 0;
+        stats.report(move_stats, this->get_name());
 
-        int maxDepth = 3; // tweak: higher depth = stronger AI but slower
+        if (ponder_enabled && best.first >= 0) {
+            tempBoard[best.first][best.second] = this->get_symbol();
+            ponder_thread = thread(&smartPlayer::ponder, this, tempBoard);
+        }
+        return best;
+    }
 
-        for (int i = 0; i < rows; i++)
-            for (int j = 0; j < cols; j++)
-                if (tempBoard[i][j] == '.') {
-                    tempBoard[i][j] = ai;
-                    int moveVal = minimax(tempBoard, false, ai, opp,
-                                          numeric_limits<int>::min(),
-                                          numeric_limits<int>::max(),
-                                          maxDepth);
-                    tempBoard[i][j] = '.';
-                    if (moveVal > bestVal) {
-                        bestVal = moveVal;
-                        bestX = i;
-                        bestY = j;
-                    }
-                }
-
-        return {bestX, bestY};
-    }
-
-    virtual ~smartPlayer() {}
+    // Runs after derived parts are gone: a derived class whose overrides or members the
+    // search uses must call stop_pondering() in its own destructor
+    virtual ~smartPlayer() { stop_pondering(); }
 };
 
 #endif //BOARDGAMEFRAMEWORK_SMART_PLAYER_H
\ No newline at end of file
@@ -0,0 +1,198 @@
+//
+// Created by abdelhamid on 12/17/25.
+//
+
+#ifndef BOARDGAMEFRAMEWORK_TABLEBASE_H
+#define BOARDGAMEFRAMEWORK_TABLEBASE_H
+
+#include "BoardGame_Classes.h"
+#include "Board_Symmetry.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Position of a solved game: the playable cells in rules order.
+ */
+struct TablebaseState {
+    char cells[9];  ///< Board characters of the playable cells.
+    int filled = 0; ///< Occupied cells, the first player is to move when it is even.
+};
+
+/**
+ * @class TablebaseRules
+ * @brief Rules of a small game as seen by the solver and the table player.
+ *
+ * A game with at most 9 playable cells describes how to read its board matrix,
+ * which moves the side to move has, what a move writes and how a move ends the
+ * game. Positions are keyed by their cells as a base-radix() number, so a key
+ * fits in 32 bits. Moves are small game specific codes (cell, or cell plus the
+ * letter / digit written there).
+ *
+ * Positions that are rotations or reflections of each other have the same
+ * value, so tables only store their canonical form (see canonical()).
+ *
+ * The rules must mirror the game's Board class exactly: the table is only a
+ * ground truth if both agree on every terminal position.
+ */
+class TablebaseRules {
+public:
+    /** @brief Result of a move for the player who made it. */
+    enum Result { ONGOING, MOVER_WINS, MOVER_LOSES, DRAW };
+
+    virtual ~TablebaseRules() {}
+
+    /** @brief Short name, also the table file stem (e.g. "misere"). */
+    virtual string name() const = 0;
+
+    /** @brief Board coordinates of playable cell i. */
+    virtual pair<int, int> cell(int i) const { return {i / 3, i % 3}; }
+
+    /** @brief Character of an empty cell. */
+    virtual char blank() const { return '.'; }
+
+    /** @brief Number of different cell characters (blank included). */
+    virtual int radix() const { return 3; }
+
+    /** @brief Key digit of a cell character, blank is 0. */
+    virtual int digit(char c) const { return c == 'X' ? 1 : (c == 'O' ? 2 : 0); }
+
+    /** @brief Append the legal move codes of the side to move. */
+    virtual void moves(const TablebaseState& s, vector<int>& out) const;
+
+    /** @brief Playable cell a move is made on. */
+    virtual int move_cell(int move) const { return move; }
+
+    /** @brief Character a move writes on its cell. */
+    virtual char move_value(const TablebaseState& s, int move) const;
+
+    /** @brief The same move made on another playable cell. */
+    virtual int move_on(int /*move*/, int cell) const { return cell; }
+
+    /** @brief Number of cell permutations the rules are invariant under (identity included). */
+    virtual int symmetries() const { return BoardSymmetry::COUNT; }
+
+    /** @brief Playable cell i under symmetry t (default: the rotations and reflections of the 3x3 board). */
+    virtual int symmetric_cell(int t, int i) const;
+
+    /** @brief How the last move ended the game. */
+    virtual Result result(const TablebaseState& s) const = 0;
+
+    /** @brief Read a position from a board matrix. */
+    TablebaseState from_matrix(const vector<vector<char>>& b) const;
+
+    /** @brief Key of a position. */
+    uint32_t key(const TablebaseState& s) const;
+
+    /**
+     * @brief Canonical form of s: the symmetric position with the smallest key.
+     * @param t Set to the symmetry giving it: cell i of the canonical form is
+     *        cell symmetric_cell(t, i) of s.
+     */
+    TablebaseState canonical(const TablebaseState& s, int& t) const;
+
+    /** @brief Key of the canonical form of s, shared by its symmetric positions. */
+    uint32_t canonical_key(const TablebaseState& s) const {
+        int t;
+        return key(canonical(s, t));
+    }
+
+    /** @brief Apply a move. */
+    void play(TablebaseState& s, int move) const {
+        s.cells[move_cell(move)] = move_value(s, move);
+        s.filled++;
+    }
+};
+
+/**
+ * @brief Rules of every game the solver knows, in solving order.
+ */
+vector<shared_ptr<const TablebaseRules>> tablebase_rules();
+
+/**
+ * @brief Rules of the game with the given name, nullptr if unknown.
+ */
+shared_ptr<const TablebaseRules> find_tablebase_rules(const string& name);
+
+/**
+ * @class Tablebase
+ * @brief Value and best move of every reachable position where a move is due.
+ *
+ * Scores are from the side to move: 0 is a draw, a win is 100 minus the plies
+ * to the end of the game and a loss the negative of that, so the best move wins
+ * fastest or loses slowest. Keys are sorted, a lookup is a binary search.
+ *
+ * Only canonical positions (TablebaseRules::canonical()) are stored, with their
+ * best move on the canonical form; lookups canonicalize first.
+ *
+ * File layout: the 8 byte magic "BGFTB001", the entry count (uint32), then the
+ * keys (uint32 each), the scores (int8 each) and the moves (uint8 each).
+ */
+class Tablebase {
+private:
+    vector<uint32_t> keys;
+    vector<int8_t> scores;
+    vector<uint8_t> moves;
+
+public:
+    /** @brief Add an entry; keys must be added in increasing order. */
+    void add(uint32_t key, int score, int move) {
+        keys.push_back(key);
+        scores.push_back(static_cast<int8_t>(score));
+        moves.push_back(static_cast<uint8_t>(move));
+    }
+
+    /** @brief Number of stored positions. */
+    size_t size() const { return keys.size(); }
+
+    /**
+     * @brief Look up a position.
+     * @return true and fill score / move if the position is stored.
+     */
+    bool lookup(uint32_t key, int& score, int& move) const;
+
+    /** @brief Write the table to a file. */
+    bool save(const string& path) const;
+
+    /** @brief Read a table written by save(). */
+    bool load(const string& path);
+
+    /**
+     * @brief Shared, loaded-once table of a game, nullptr if no table file is found.
+     *
+     * Looks for `<name>.tb` in $BGF_TABLES, then in tables/ and ../tables/.
+     */
+    static shared_ptr<const Tablebase> find(const string& name);
+};
+
+/**
+ * @class TablebasePlayer
+ * @brief Computer player that answers by table lookup (perfect play, no search).
+ */
+class TablebasePlayer : public Player<char> {
+private:
+    shared_ptr<const TablebaseRules> rules;
+    shared_ptr<const Tablebase> table;
+
+public:
+    /**
+     * @brief Move chosen from the table.
+     */
+    struct TableMove {
+        int x = -1, y = -1; ///< Board coordinates, -1 if the position is not in the table.
+        char value = 0;     ///< Character the move writes (symbol, letter or digit).
+        int score = 0;      ///< Table score of the position for the side to move.
+    };
+
+    TablebasePlayer(string name, char symbol, PlayerType type,
+                    shared_ptr<const TablebaseRules> rules, shared_ptr<const Tablebase> table)
+        : Player<char>(name, symbol, type), rules(rules), table(table) {}
+
+    /** @brief Best move on the current board. */
+    TableMove table_move() const;
+};
+
+#endif //BOARDGAMEFRAMEWORK_TABLEBASE_H
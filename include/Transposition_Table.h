@@ -0,0 +1,251 @@
+//
+// Created by abdelhamid on 12/14/25.
+//
+
+#ifndef BOARDGAMEFRAMEWORK_TRANSPOSITION_TABLE_H
+#define BOARDGAMEFRAMEWORK_TRANSPOSITION_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class ZobristKeys
+ * @brief Random 64-bit keys per (cell, side) used to hash positions incrementally.
+ *
+ * A position key is the XOR of the keys of every occupied cell, plus
+ * side_to_move() when the second side is to move. Making or undoing a move
+ * only XORs the keys of the cells it touches, so searches can carry the key
+ * down the tree instead of rehashing the whole board at every node.
+ */
+class ZobristKeys {
+private:
+    vector<uint64_t> keys; ///< Two keys per cell (side 0, side 1).
+    uint64_t side_key = 0; ///< Toggled on every move.
+    int columns = 0;       ///< Board width used to map (x, y) to a cell.
+
+    /** @brief SplitMix64 step, gives well mixed deterministic keys. */
+    static uint64_t next(uint64_t& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+public:
+    ZobristKeys() {}
+
+    /**
+     * @brief Generate keys for a rows x cols board (no-op if already sized).
+     */
+    void resize(int rows, int cols) {
+        if ((int)keys.size() == rows * cols * 2 && columns == cols) return;
+        columns = cols;
+        keys.resize(rows * cols * 2);
+        uint64_t state = 0x2545F4914F6CDD1DULL;
+        for (auto& k : keys) k = next(state);
+        side_key = next(state);
+    }
+
+    /** @brief Key of side (0 or 1) owning cell (x, y). */
+    uint64_t piece(int x, int y, int side) const {
+        return keys[(x * columns + y) * 2 + side];
+    }
+
+    /** @brief Key XORed in on every move to encode the side to move. */
+    uint64_t side_to_move() const { return side_key; }
+};
+
+/**
+ * @brief Kind of bound a transposition table value represents.
+ */
+enum class BoundType : uint8_t {
+    EXACT, ///< Value is exact (searched inside the window).
+    LOWER, ///< Search failed high: value is a lower bound.
+    UPPER  ///< Search failed low: value is an upper bound.
+};
+
+/**
+ * @class TableScore
+ * @brief Win and loss scores as kept in a transposition table.
+ *
+ * Searches score a win as win plus the remaining depth of the node where it
+ * happens (a loss as the negation), so the same win is worth another score from
+ * another ply, iteration or move. Tables keep it relative to the stored node
+ * instead (win minus the plies to the win), and from_table() converts it back
+ * at the probing node. Scores within MAX_PLIES of +-win are taken for wins and
+ * losses, so a game's other scores must stay clear of that band.
+ */
+class TableScore {
+public:
+    static constexpr int MAX_PLIES = 256; ///< Deeper than any search.
+
+    /** @brief Score to store for a node with the given remaining depth. */
+    static int to_table(int value, int depth, int win = 1000) {
+        if (value >= win && value <= win + MAX_PLIES) return value - depth;
+        if (value <= -win && value >= -win - MAX_PLIES) return value + depth;
+        return value;
+    }
+
+    /** @brief Score of a stored value at a node with the given remaining depth. */
+    static int from_table(int value, int depth, int win = 1000) {
+        if (value >= win - MAX_PLIES && value <= win) return value + depth;
+        if (value <= -win + MAX_PLIES && value >= -win) return value - depth;
+        return value;
+    }
+};
+
+/**
+ * @brief One slot of the transposition table.
+ */
+struct TTEntry {
+    uint64_t key = 0;         ///< Full position key (0 = empty slot).
+    int value = 0;            ///< Stored score.
+    int16_t depth = -1;       ///< Remaining depth the value was searched to.
+    int16_t best_move = -1;   ///< Game specific move index, -1 if none.
+    BoundType flag = BoundType::EXACT;
+    uint8_t generation = 0;   ///< Search that wrote the entry.
+};
+
+/**
+ * @class TranspositionTable
+ * @brief Fixed-size, direct-mapped cache of searched positions.
+ *
+ * Replacement scheme: an entry is overwritten when it belongs to the same
+ * position, comes from an older search, or was searched less deeply than the
+ * new result. The table never grows after construction.
+ */
+class TranspositionTable {
+private:
+    vector<TTEntry> entries; ///< Power-of-two sized slot array.
+    uint64_t mask;           ///< entries.size() - 1.
+    uint8_t generation = 0;  ///< Current search, bumped by new_search().
+
+public:
+    /**
+     * @brief Construct a table with 2^size_log2 slots.
+     */
+    explicit TranspositionTable(int size_log2 = 16)
+        : entries(size_t(1) << size_log2), mask((uint64_t(1) << size_log2) - 1) {}
+
+    /**
+     * @brief Look up a position.
+     * @return true and fill out if the position is stored.
+     */
+    bool probe(uint64_t key, TTEntry& out) const {
+        const TTEntry& e = entries[key & mask];
+        if (e.key != key || e.depth < 0) return false;
+        out = e;
+        return true;
+    }
+
+    /**
+     * @brief Store a search result, subject to the replacement scheme.
+     */
+    void store(uint64_t key, int depth, int value, BoundType flag, int best_move) {
+        TTEntry& e = entries[key & mask];
+        if (e.key != key && e.generation == generation && e.depth > depth) return;
+        e.key = key;
+        e.value = value;
+        e.depth = static_cast<int16_t>(depth);
+        e.best_move = static_cast<int16_t>(best_move);
+        e.flag = flag;
+        e.generation = generation;
+    }
+
+    /** @brief Mark existing entries as old so the next search can replace them. */
+    void new_search() { generation++; }
+
+    /** @brief Drop every stored entry. */
+    void clear() {
+        for (auto& e : entries) e = TTEntry();
+        generation = 0;
+    }
+};
+
+/**
+ * @class SharedTranspositionTable
+ * @brief TranspositionTable that many threads probe and store at once, without locks.
+ *
+ * A slot is two 64-bit words written separately: the entry packed in one
+ * (value 32 bits, depth + 1, best move + 1, bound, generation) and the key
+ * XORed with it in the other. Threads writing the same slot at once can leave
+ * the words of two different entries; XORing them back then gives a wrong key,
+ * so a torn slot reads as a miss instead of a corrupt hit. Same replacement
+ * scheme as TranspositionTable; depths must be below 255 and moves below 65535.
+ */
+class SharedTranspositionTable {
+private:
+    struct Slot {
+        atomic<uint64_t> check{0}; ///< key ^ data.
+        atomic<uint64_t> data{0};  ///< Packed entry, 0 = empty (a stored depth + 1 is never 0).
+    };
+
+    vector<Slot> slots;     ///< Power-of-two sized slot array.
+    uint64_t mask;          ///< slots.size() - 1.
+    uint8_t generation = 0; ///< Current search (6 bits kept), bumped by new_search().
+
+    static uint64_t pack(int depth, int value, BoundType flag, int best_move, uint8_t generation) {
+        return uint64_t(static_cast<uint32_t>(value)) |
+               uint64_t(static_cast<uint8_t>(depth + 1)) << 32 |
+               uint64_t(static_cast<uint16_t>(best_move + 1)) << 40 |
+               uint64_t(static_cast<uint8_t>(flag)) << 56 |
+               uint64_t(generation & 63) << 58;
+    }
+
+public:
+    /**
+     * @brief Construct a table with 2^size_log2 slots.
+     */
+    explicit SharedTranspositionTable(int size_log2 = 16)
+        : slots(size_t(1) << size_log2), mask((uint64_t(1) << size_log2) - 1) {}
+
+    /**
+     * @brief Look up a position.
+     * @return true and fill out if the position is stored.
+     */
+    bool probe(uint64_t key, TTEntry& out) const {
+        const Slot& s = slots[key & mask];
+        uint64_t data = s.data.load(memory_order_relaxed);
+        if (data == 0 || (s.check.load(memory_order_relaxed) ^ data) != key) return false;
+        out.key = key;
+        out.value = static_cast<int32_t>(static_cast<uint32_t>(data));
+        out.depth = static_cast<int16_t>(((data >> 32) & 0xFF) - 1);
+        out.best_move = static_cast<int16_t>(((data >> 40) & 0xFFFF) - 1);
+        out.flag = static_cast<BoundType>((data >> 56) & 3);
+        out.generation = static_cast<uint8_t>(data >> 58);
+        return true;
+    }
+
+    /**
+     * @brief Store a search result, subject to the replacement scheme.
+     */
+    void store(uint64_t key, int depth, int value, BoundType flag, int best_move) {
+        Slot& s = slots[key & mask];
+        uint64_t old = s.data.load(memory_order_relaxed);
+        if (old != 0) {
+            bool same = (s.check.load(memory_order_relaxed) ^ old) == key;
+            int old_depth = static_cast<int>((old >> 32) & 0xFF) - 1;
+            if (!same && (old >> 58) == (generation & 63u) && old_depth > depth) return;
+        }
+        uint64_t data = pack(depth, value, flag, best_move, generation);
+        s.check.store(key ^ data, memory_order_relaxed);
+        s.data.store(data, memory_order_relaxed);
+    }
+
+    /** @brief Mark existing entries as old so the next search can replace them (no search may be running). */
+    void new_search() { generation++; }
+
+    /** @brief Drop every stored entry (no search may be running). */
+    void clear() {
+        for (auto& s : slots) {
+            s.check.store(0, memory_order_relaxed);
+            s.data.store(0, memory_order_relaxed);
+        }
+        generation = 0;
+    }
+};
+
+#endif //BOARDGAMEFRAMEWORK_TRANSPOSITION_TABLE_H
@@ -0,0 +1,117 @@
+//
+// Created by abdelhamid on 12/18/25.
+//
+
+#ifndef BOARDGAMEFRAMEWORK_ULTIMATE_MCTS_H
+#define BOARDGAMEFRAMEWORK_ULTIMATE_MCTS_H
+
+#include "BoardGame_Classes.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+using namespace std;
+
+/**
+ * @brief Bitboard copy of an Ultimate X-O position, cheap enough to copy for every playout.
+ *
+ * Cell index = sub-board * 9 + position in the sub-board, both numbered row by row
+ * (board cell (x, y) is in sub-board (x/3)*3 + y/3 at position (x%3)*3 + y%3).
+ * Rules follow Ultimate_XO_Board: any empty cell may be played, and the first
+ * player to own a line of a sub-board claims it on the main board.
+ */
+struct UltimateState {
+    uint16_t cells[2][9] = {}; ///< Owned cells of each sub-board, per side (0 = X, 1 = O).
+    uint16_t claimed[2] = {};  ///< Sub-boards claimed on the main board, per side.
+    int moves = 0;             ///< Occupied cells.
+    int to_move = 0;           ///< Side to move.
+    int winner = -1;           ///< Side owning a main board line, -1 if none.
+
+    /** @brief Read a position from the 9x9 board and the 3x3 main board. */
+    static UltimateState from_boards(const vector<vector<char>>& board, const vector<vector<char>>& main, int to_move);
+
+    /** @brief Whether the game is over (main board line, or no empty cell left). */
+    bool over() const { return winner >= 0 || moves == 81; }
+
+    /** @brief Whether cell is empty. */
+    bool empty(int cell) const {
+        uint16_t bit = 1u << (cell % 9);
+        return !((cells[0][cell / 9] | cells[1][cell / 9]) & bit);
+    }
+
+    /** @brief Play cell for the side to move (the cell must be empty). */
+    void play(int cell);
+};
+
+/**
+ * @brief One node of the search tree, stored in a preallocated pool.
+ *
+ * Children of a node are contiguous in the pool. Counters are atomics so that
+ * several threads can walk and update the same tree.
+ */
+struct MCTSNode {
+    atomic<int32_t> visits{0}; ///< Playouts through the node, in-flight ones included (virtual loss).
+    atomic<int32_t> score{0};  ///< 2 per win and 1 per draw of the side that played `move`.
+    int32_t first_child = -1;  ///< Pool index of the first child.
+    uint8_t child_count = 0;   ///< Number of children.
+    uint8_t move = 0;          ///< Cell played to reach the node.
+    atomic<uint8_t> state{0};  ///< 0 = leaf, 1 = being expanded, 2 = expanded.
+};
+
+/**
+ * @class UltimateMCTSPlayer
+ * @brief Monte Carlo Tree Search (UCT) player for Ultimate Tic-Tac-Toe.
+ *
+ * Each iteration walks the tree with UCT, expands the reached leaf, finishes the
+ * game with random moves on an UltimateState copy and backs the result up the
+ * path. The search stops when the playout or time budget is spent and plays the
+ * most visited root move.
+ *
+ * With several search threads all of them work on the same tree (tree
+ * parallelism). A thread counts its visit on every node it walks through before
+ * the result is known, which lowers the node's value for the others (virtual
+ * loss) and spreads the threads over different lines.
+ */
+class UltimateMCTSPlayer : public Player<char> {
+private:
+    int time_budget_ms = 1000;   ///< Wall-clock budget per move.
+    int playout_budget = 0;      ///< Playouts per move, 0 = limited by time only.
+    int search_threads = 1;      ///< Threads sharing the tree (0 = one per hardware thread).
+    int pool_size = 1 << 20;     ///< Nodes available per move.
+    double exploration = 1.4;    ///< UCT exploration constant.
+
+    unique_ptr<MCTSNode[]> pool; ///< Allocated on the first search.
+    atomic<int> pool_used{0};    ///< Nodes handed out in the current search.
+
+    /** @brief Reset the nodes used by the previous search and create the root. */
+    void reset_tree();
+
+    /** @brief Create the children of node for every empty cell of s; false if not expanded. */
+    bool expand(MCTSNode& node, const UltimateState& s);
+
+    /** @brief Child of node with the best UCT value. */
+    MCTSNode& select_child(MCTSNode& node);
+
+    /** @brief One selection / expansion / playout / backup pass from the root. */
+    void iterate(const UltimateState& root, uint64_t& rng);
+
+public:
+    UltimateMCTSPlayer(string name, char symbol, PlayerType type) : Player<char>(name, symbol, type) {}
+
+    /** @brief Per-move wall-clock budget. */
+    void set_time_budget(int ms) { time_budget_ms = ms; }
+
+    /** @brief Playouts per move, 0 = limited by time only. */
+    void set_playouts(int playouts) { playout_budget = playouts; }
+
+    /** @brief Threads searching the shared tree (0 = one per hardware thread). */
+    void set_search_threads(int threads) { search_threads = threads; }
+
+    /** @brief Nodes of the preallocated pool; when it is full the tree stops growing. */
+    void set_pool_size(int nodes);
+
+    /** @brief Search the current position and return the board cell to play. */
+    pair<int, int> calculateMove();
+};
+
+#endif //BOARDGAMEFRAMEWORK_ULTIMATE_MCTS_H
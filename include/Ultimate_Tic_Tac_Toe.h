@@ -6,10 +6,12 @@
 #define BOARDGAMEFRAMEWORK_ULTIMATE_TIC_TAC_TOE_H
 
 #include "BoardGame_Classes.h"
+#include "BitBoard.h"
 
 class mainBoard : public Board<char> {
 private:
     char blank_symbol = '.';
+    BitBoard bits; ///< X/O masks of the won sub-boards, mirrored for fast line checks.
 public:
     /**
      *@brief Default constructor that initializes a 3*3 main Board;
@@ -29,7 +31,14 @@ public:
     * @param player Pointer to the player being checked.
     * @return true if the player has a winning line, false otherwise.
     */
-    bool is_win(Player<char>* player);
+    bool is_win(Player<char>* player) { return is_win(player->get_symbol()); }
+
+    /**
+     * @brief Checks if the player using the given symbol has won the game.
+     * @param symbol Symbol of the player being checked.
+     * @return true if the player has a winning line, false otherwise.
+     */
+    bool is_win(char symbol);
     /**
      * @brief Checks if the given player has lost the game.
      * @param player Pointer to the player being checked.
@@ -51,6 +60,15 @@ public:
      */
     bool game_is_over(Player<char>* player);
 
+    /** @brief Independent copy of the board, used by multi-threaded searches. */
+    Board<char>* clone() const { return new mainBoard(*this); }
+
+    /** @brief Save the cells, move count and bitboard (see Board::snapshot()). */
+    bool snapshot(BoardSnapshot& s) const;
+
+    /** @brief Return to a state saved by snapshot(). */
+    bool restore(const BoardSnapshot& s);
+
     virtual ~mainBoard(){};
 };
 
@@ -64,6 +82,14 @@ public:
      */
     Ultimate_XO_Board();
 
+    /**
+     * @brief Copy constructor, deep copies the main board so each copy owns its own.
+     */
+    Ultimate_XO_Board(const Ultimate_XO_Board& other)
+        : Board<char>(other), blank_symbol(other.blank_symbol), mainBoardPtr(other.mainBoardPtr->clone()) {}
+
+    Ultimate_XO_Board& operator=(const Ultimate_XO_Board&) = delete;
+
     /**
      * @brief Updates the board with a player's move.
      * @param move Pointer to a Move<char> object containing move coordinates and symbol.
@@ -77,7 +103,14 @@ public:
     * @param player Pointer to the player being checked.
     * @return true if the player has a winning line, false otherwise.
     */
-    bool is_win(Player<char>* player);
+    bool is_win(Player<char>* player) { return is_win(player->get_symbol()); }
+
+    /**
+     * @brief Checks if the player using the given symbol has won the game.
+     * @param symbol Symbol of the player being checked.
+     * @return true if the player has a winning line, false otherwise.
+     */
+    bool is_win(char symbol);
     /**
      * @brief Checks if the given player has lost the game.
      * @param player Pointer to the player being checked.
@@ -99,6 +132,20 @@ public:
      */
     bool game_is_over(Player<char>* player);
 
+    /** @brief Independent copy of the board, used by multi-threaded searches. */
+    Board<char>* clone() const { return new Ultimate_XO_Board(*this); }
+
+    /** @brief Save the cells and move count of both the 9x9 board and the main board (see Board::snapshot()). */
+    bool snapshot(BoardSnapshot& s) const;
+
+    /** @brief Return to a state saved by snapshot(). */
+    bool restore(const BoardSnapshot& s);
+
+    /**
+     * @brief Owners of the sub-boards (3x3, blank if not claimed yet).
+     */
+    vector<vector<char>> get_main_board_matrix() const { return mainBoardPtr->get_board_matrix(); }
+
     virtual ~Ultimate_XO_Board() {
         delete mainBoardPtr;
     };
@@ -0,0 +1,150 @@
+//
+// Created by abdelhamid on 12/19/25.
+//
+
+#ifndef BOARDGAMEFRAMEWORK_WORD_DICTIONARY_H
+#define BOARDGAMEFRAMEWORK_WORD_DICTIONARY_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class WordDictionary
+ * @brief Prefix tree (trie) over the words of a dictionary file.
+ *
+ * Words are stored in upper case. Besides exact lookups the trie answers
+ * pattern queries: whether a line with blank cells can still be completed
+ * into a word of exactly its length, which lets searches drop lines (and
+ * letters) that can no longer matter.
+ *
+ * A loaded dictionary is never modified, so one instance is shared by every
+ * board and player (see shared()).
+ *
+ * Three-letter lines (every line of Word X-O) are answered without the trie:
+ * a bitset over the 26^3 letter triples says which are words, and a table
+ * over the 27^3 patterns (letter or blank in each cell) counts the words each
+ * pattern can still become.
+ *
+ * The trie is a flat array of fixed-size nodes, so it can be saved as is
+ * (bgf_dictc, run by the build, compiles dic.txt into dic.bin) and mapped
+ * read-only from that file: no parsing at startup, and processes using the
+ * same file share its pages. File layout: the 8 byte magic "BGFDIC02", the
+ * node count, word count and letter mask (uint32 each, bit i = letter 'A'+i)
+ * and 4 reserved bytes, the three-letter bitset (uint64 words), the pattern
+ * counts (uint16 each, padded to 4 bytes), then the nodes, root first, all in
+ * native byte order.
+ */
+class WordDictionary {
+private:
+    /** @brief Trie node, children indexed by letter (-1 = none). */
+    struct Node {
+        int32_t next[26];
+        int32_t word = 0; ///< 1 if a word ends here.
+        Node() { for (auto& n : next) n = -1; }
+    };
+
+    static constexpr int TRIPLES = 26 * 26 * 26;  ///< Three-letter words, index 676a + 26b + c.
+    static constexpr int PATTERNS = 27 * 27 * 27; ///< Three-cell patterns, blank = 26.
+
+    vector<Node> owned{1};         ///< Nodes built by insert() (nodes[0] is the root).
+    vector<uint64_t> owned_triples = vector<uint64_t>((TRIPLES + 63) / 64);
+    vector<uint16_t> owned_patterns = vector<uint16_t>(PATTERNS);
+    const Node* mapped = nullptr;  ///< Nodes of a mapped file, used instead of `owned`.
+    size_t mapped_nodes = 0;
+    const uint64_t* triples = owned_triples.data();  ///< Bit set for each three-letter word.
+    const uint16_t* patterns = owned_patterns.data(); ///< Words matching each three-cell pattern.
+    void* mapping = nullptr;       ///< Start and length of the file mapping.
+    size_t mapping_size = 0;
+    size_t words = 0;              ///< Number of distinct words.
+    string used_letters;           ///< Letters that appear in at least one word, in alphabetical order.
+
+    const Node* nodes() const { return mapped ? mapped : owned.data(); }
+    bool match(int node, const string& pattern, size_t i, char blank) const;
+
+public:
+    WordDictionary() = default;
+    ~WordDictionary();
+    WordDictionary(const WordDictionary&) = delete;
+    WordDictionary& operator=(const WordDictionary&) = delete;
+
+    /** @brief Add a word (letters other than A-Z make it ignored). */
+    void insert(const string& word);
+
+    /**
+     * @brief Load one word per line (surrounding whitespace is trimmed).
+     * @return false if the file cannot be opened.
+     */
+    bool load(const string& path);
+
+    /** @brief Write the trie in the compiled format. */
+    bool save_compiled(const string& path) const;
+
+    /**
+     * @brief Use a file written by save_compiled(), mapped read-only where mmap is available.
+     * @return false if the file cannot be opened or is not a compiled dictionary.
+     */
+    bool load_compiled(const string& path);
+
+    /** @brief Whether the word is in the dictionary (case-insensitive). */
+    bool contains(const string& word) const;
+
+    /** @brief Letter index 0-25 of an upper-case letter, -1 for anything else. */
+    static int letter_index(char c) { return c >= 'A' && c <= 'Z' ? c - 'A' : -1; }
+
+    /** @brief Whether the upper-case letters a, b, c spell a word: one bit lookup. */
+    bool is_word(char a, char b, char c) const {
+        int i = letter_index(a), j = letter_index(b), k = letter_index(c);
+        if ((i | j | k) < 0) return false;
+        int key = (i * 26 + j) * 26 + k;
+        return (triples[key >> 6] >> (key & 63)) & 1;
+    }
+
+    /**
+     * @brief Number of three-letter words matching the cells a, b, c: one table lookup.
+     * @param blank Character of a blank cell, it matches any letter.
+     */
+    int completions(char a, char b, char c, char blank = '.') const {
+        int key = 0;
+        for (char cell : {a, b, c}) {
+            int i = cell == blank ? 26 : letter_index(cell);
+            if (i < 0) return 0;
+            key = key * 27 + i;
+        }
+        return patterns[key];
+    }
+
+    /**
+     * @brief Whether some word of exactly pattern's length matches it.
+     * @param pattern Letters and blank cells.
+     * @param blank Character of a blank cell, it matches any letter.
+     */
+    bool can_complete(const string& pattern, char blank = '.') const;
+
+    /** @brief Number of distinct words. */
+    size_t size() const { return words; }
+
+    /** @brief Letters used by the words, A-Z if the dictionary is empty. */
+    string letters() const { return used_letters.empty() ? "ABCDEFGHIJKLMNOPQRSTUVWXYZ" : used_letters; }
+
+    /**
+     * @brief Dictionary of the given file, loaded once and shared by all callers.
+     *
+     * Files ending in ".bin" are compiled dictionaries, others word lists.
+     * A file that cannot be opened gives an empty dictionary (with a warning).
+     */
+    static shared_ptr<const WordDictionary> shared(const string& path);
+
+    /**
+     * @brief The games' dictionary, loaded once and shared by all callers.
+     *
+     * Uses $BGF_DICT if set, else the first of dic.bin, ../dic.bin, dic.txt
+     * and ../dic.txt that exists.
+     */
+    static shared_ptr<const WordDictionary> shared();
+};
+
+#endif //BOARDGAMEFRAMEWORK_WORD_DICTIONARY_H
@@ -9,6 +9,7 @@
  */
 
 #include "BoardGame_Classes.h"
+#include "BitBoard.h"
 using namespace std;
 
 #ifndef WORDS_XO_H
@@ -28,6 +29,9 @@ class Word_XO_Board : public Board<char> {
 private:
     char blank_symbol = '.'; ///< Character used to represent an empty cell on the board.
     int counter;             ///< Counter to track the number of moves or game state progression.
+    BitBoard bits;           ///< Occupied cells (side 0), used to skip lines that are not full yet.
+    int word_lines = 0;      ///< Full lines that spell a word, updated on each placement.
+    char last_symbol = 0;    ///< Player who made the last move.
 
 public:
     /**
@@ -47,7 +51,14 @@ public:
      * @param player Pointer to the player being checked.
      * @return true if the player has formed a winning word configuration, false otherwise.
      */
-    bool is_win(Player<char>* player);
+    bool is_win(Player<char>* player) { return is_win(player->get_symbol()); }
+
+    /**
+     * @brief Checks if the player using the given symbol has won the game.
+     * @param symbol Symbol of the player being checked.
+     * @return true if the player just formed a word, false otherwise.
+     */
+    bool is_win(char symbol);
 
     /**
      * @brief Checks if the given player has lost the game.
@@ -69,6 +80,15 @@ public:
      * @return true if the game has ended, false otherwise.
      */
     bool game_is_over(Player<char>* player);
+
+    /** @brief Independent copy of the board, used by multi-threaded searches. */
+    Board<char>* clone() const { return new Word_XO_Board(*this); }
+
+    /** @brief Save the cells, move count, word count and last mover (see Board::snapshot()). */
+    bool snapshot(BoardSnapshot& s) const;
+
+    /** @brief Return to a state saved by snapshot(). */
+    bool restore(const BoardSnapshot& s);
 };
 
 
@@ -3,6 +3,8 @@
 
 
 #include "BoardGame_Classes.h"
+#include "BitBoard.h"
+#include "Line_Counter.h"
 using namespace std;
 
 
@@ -10,6 +12,7 @@ class X_O_5x5_Board : public Board<char> {
 private:
     char blank_symbol = '.';
     int counter;
+    LineCounter lines; // every run of 3 cells, the score is the number of runs a player owns
 
 public:
 
@@ -19,7 +22,9 @@ public:
     bool update_board(Move<char>* move);
 
 
-    bool is_win(Player<char>* player);
+    bool is_win(Player<char>* player) { return is_win(player->get_symbol()); }
+
+    bool is_win(char symbol);
 
 
     bool is_lose(Player<char>* player);
@@ -29,6 +34,15 @@ public:
 
 
     bool game_is_over(Player<char>* player);
+
+    /** @brief Independent copy of the board, used by multi-threaded searches. */
+    Board<char>* clone() const { return new X_O_5x5_Board(*this); }
+
+    /** @brief Save the cells and move count; the line counts are rebuilt on restore (see Board::snapshot()). */
+    bool snapshot(BoardSnapshot& s) const;
+
+    /** @brief Return to a state saved by snapshot(). */
+    bool restore(const BoardSnapshot& s);
 };
 
 class X_O_5x5_UI : public UI<char> {
@@ -6,17 +6,99 @@
 #define BOARDGAMEFRAMEWORK_GAMESMENU_H
 
 #include "BoardGame_Classes.h"
+#include "Smart_Player.h"
+#include "AiPlayer.h"
+#include "Ultimate_MCTS.h"
+#include "Game_Record.h"
+#include "Search_Stats.h"
+#include <cstdlib>
 #include <map>
+#include <memory>
 
 using namespace std;
 
+/**
+ * @brief Search settings applied to a computer player before a headless game.
+ *
+ * Negative values keep the player's own default. Settings a player does not
+ * support (e.g. a time budget for a random player) are ignored.
+ */
+struct PlayerSettings {
+    int time_budget_ms = -1; ///< Per-move budget of smartPlayer searches.
+    int max_depth = -1;      ///< Iteration cap (smartPlayer) or search depth (AIPlayer).
+    int search_threads = -1; ///< Root split / tree threads, 0 = one per hardware thread.
+    int playouts = -1;       ///< Playouts per move of MCTS players, 0 = limited by time only.
+    int ponder = -1;         ///< 1 to search on the opponent's time (smartPlayer, AIPlayer), 0 not to.
+    string name;             ///< Player name in game records, empty for the default.
+};
+
+/**
+ * @brief UI, board and players of a game whose turns are driven by the caller (see bgf_server).
+ */
+struct GameSession {
+    unique_ptr<UI<char>> ui;
+    unique_ptr<Board<char>> board;
+    unique_ptr<Player<char>> players[2]; ///< X, then O; both already point to the board.
+    RecordedMoveType move_type = RecordedMoveType::PLAIN; ///< What a move carries besides its cell.
+};
+
 /**
  * @brief a base interface for launching a game
  */
 class GameLauncher {
+protected:
+    GameRecordWriter* records = nullptr; ///< Where finished games are recorded, if set.
+    int game_id = 0;                     ///< Menu number written in the records.
+    SearchStatsSink* stats = nullptr;    ///< Receives the search statistics of every computer move, if set.
+
 public:
+    /**
+     * @brief Record the games played from now on (nullptr to stop).
+     * @param writer Record file, may be shared by games running on several threads.
+     * @param id Menu number of the game.
+     */
+    void set_recording(GameRecordWriter* writer, int id) {
+        records = writer;
+        game_id = id;
+    }
+
+    /**
+     * @brief Send the search statistics of the computer players of the next games to sink (nullptr to stop).
+     * @param sink Shared by games running on several threads.
+     */
+    void set_stats(SearchStatsSink* sink) {
+        stats = sink;
+    }
+
     virtual void launch() = 0;
     virtual string get_name() const = 0;
+
+    /**
+     * @brief Play one game between two computer players without console input.
+     * @param settings Settings of the first (X) and second (O) player.
+     * @param max_moves Moves after which the game is stopped as unfinished.
+     * @param max_retries Rejected moves in a row after which the game is stopped as unfinished.
+     */
+    virtual GameOutcome play_headless(const PlayerSettings settings[2], int max_moves, int max_retries) = 0;
+
+    /**
+     * @brief Create a game without playing it.
+     * @param types Type of the first (X) and second (O) player.
+     * @param settings Settings of the computer players.
+     */
+    virtual unique_ptr<GameSession> new_session(const PlayerType types[2], const PlayerSettings settings[2]) = 0;
+
+    /**
+     * @brief Whether several games of this kind can be played at the same time on different threads.
+     */
+    virtual bool parallel_safe() const { return true; }
+
+    /**
+     * @brief Play a recorded game of this kind on a new board.
+     * @return false if the board rejects one of its moves.
+     */
+    virtual bool replay(const GameRecord& record) const = 0;
+
     virtual ~GameLauncher() {}
 };
 
@@ -25,20 +107,104 @@ template<typename T, typename UIType, typename BoardType>
 class XOGameLauncher : public GameLauncher {
 private:
     string name;
+    bool shares_state; ///< Game keeps state outside its board, so games cannot overlap.
+
+    void apply_settings(Player<T>* player, const PlayerSettings& s) const {
+        if (auto smart = dynamic_cast<smartPlayer<T>*>(player)) {
+            smart->set_stats_sink(stats, name);
+            if (s.time_budget_ms >= 0) smart->set_time_budget(s.time_budget_ms);
+            if (s.max_depth >= 0) smart->set_max_depth(s.max_depth);
+            if (s.search_threads >= 0) smart->set_search_threads(s.search_threads);
+            if (s.ponder >= 0) smart->set_pondering(s.ponder > 0);
+        } else if (auto ai = dynamic_cast<AIPlayer<T>*>(player)) {
+            ai->set_stats_sink(stats, name);
+            if (s.max_depth >= 0) ai->set_max_depth(s.max_depth);
+            if (s.search_threads >= 0) ai->set_search_threads(s.search_threads);
+            if (s.ponder >= 0) ai->set_pondering(s.ponder > 0);
+        } else if (auto mcts = dynamic_cast<UltimateMCTSPlayer*>(player)) {
+            if (s.time_budget_ms >= 0) mcts->set_time_budget(s.time_budget_ms);
+            if (s.playouts >= 0) mcts->set_playouts(s.playouts);
+            if (s.search_threads >= 0) mcts->set_search_threads(s.search_threads);
+        }
+    }
 
 public:
-    XOGameLauncher(const string& n) : name(n) {}
+    XOGameLauncher(const string& n, bool shares_state = false) : name(n), shares_state(shares_state) {}
 
     string get_name() const override {
         return name;
     }
 
+    bool parallel_safe() const override {
+        return !shares_state;
+    }
+
+    bool replay(const GameRecord& record) const override {
+        BoardType board;
+        return record.replay(board);
+    }
+
+    GameOutcome play_headless(const PlayerSettings settings[2], int max_moves, int max_retries) override {
+        UI<T>* ui = new UIType();
+        Board<T>* board = new BoardType();
+        Player<T>* players[2];
+        string names[2] = {"Player X", "Player O"};
+        T symbols[2] = {static_cast<T>('X'), static_cast<T>('O')};
+        for (int i = 0; i < 2; i++) {
+            if (!settings[i].name.empty()) names[i] = settings[i].name;
+            players[i] = ui->create_player(names[i], symbols[i], PlayerType::COMPUTER);
+            apply_settings(players[i], settings[i]);
+        }
+
+        GameManager<T> game(board, players, ui);
+        unique_ptr<GameRecorder> recorder;
+        if (records) {
+            recorder.reset(new GameRecorder(*records, game_id));
+            game.set_recorder(recorder.get());
+        }
+        GameOutcome outcome = game.run_headless(max_moves, max_retries);
+
+        delete board;
+        delete ui;
+        for (int i = 0; i < 2; i++)
+            delete players[i];
+        return outcome;
+    }
+
+    unique_ptr<GameSession> new_session(const PlayerType types[2], const PlayerSettings settings[2]) override {
+        unique_ptr<GameSession> session(new GameSession());
+        session->ui.reset(new UIType());
+        session->board.reset(new BoardType());
+        string names[2] = {"Player X", "Player O"};
+        T symbols[2] = {static_cast<T>('X'), static_cast<T>('O')};
+        for (int i = 0; i < 2; i++) {
+            if (!settings[i].name.empty()) names[i] = settings[i].name;
+            session->players[i].reset(session->ui->create_player(names[i], symbols[i], types[i]));
+            apply_settings(session->players[i].get(), settings[i]);
+            session->players[i]->set_board_ptr(session->board.get());
+        }
+        session->move_type = recorded_move_type(*session->board);
+        return session;
+    }
+
     void launch() override {
         UI<T>* ui = new UIType();
         Board<T>* board = new BoardType();
         Player<T>** players = ui->setup_players();
 
+        // A computer playing a human searches while the human thinks
+        for (int i = 0; i < 2; i++) {
+            PlayerSettings settings;
+            if (players[1 - i]->get_type() == PlayerType::HUMAN) settings.ponder = 1;
+            apply_settings(players[i], settings);
+        }
+
         GameManager<T> game(board, players, ui);
+        unique_ptr<GameRecorder> recorder;
+        if (records) {
+            recorder.reset(new GameRecorder(*records, game_id));
+            game.set_recorder(recorder.get());
+        }
         game.run();
 
         delete board;
@@ -52,6 +218,8 @@ public:
 class Menu {
 private:
     map<int, GameLauncher*> options;
+    unique_ptr<GameRecordWriter> records; ///< Record file of the games played from the menu.
+    unique_ptr<SearchStatsFile> stats;    ///< Search statistics of the computer moves.
 
 public:
     Menu() {
@@ -75,6 +243,13 @@ public:
         for (auto& p : options) delete p.second;
     }
 
+    /**
+     * @brief Registered games by menu number.
+     */
+    const map<int, GameLauncher*>& get_options() const {
+        return options;
+    }
+
     void print_menu() {
         cout << "\n-- Welcome to the FCAI Board Game Collection --\n";
         cout << "------------------------------------------------\n";
@@ -88,6 +263,21 @@ public:
     }
 
     void run() {
+        // $BGF_RECORD names a file the games are appended to (see GameRecordWriter)
+        if (const char* path = getenv("BGF_RECORD")) {
+            records.reset(new GameRecordWriter(path));
+            if (!records->is_open()) cout << "Cannot open " << path << " for recording\n";
+            for (auto& item : options)
+                item.second->set_recording(records->is_open() ? records.get() : nullptr, item.first);
+        }
+        // $BGF_STATS names a file that gets one JSON line per computer move (see SearchStats)
+        if (const char* path = getenv("BGF_STATS")) {
+            stats.reset(new SearchStatsFile(path));
+            if (!stats->is_open()) cout << "Cannot open " << path << " for search statistics\n";
+            for (auto& item : options)
+                item.second->set_stats(stats->is_open() ? stats.get() : nullptr);
+        }
+
         int choice;
         while (true) {
             print_menu();
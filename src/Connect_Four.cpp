@@ -0,0 +1,288 @@
+//
+// Created by abdelhamid on 12/22/25.
+//
+
+#include "../include/Connect_Four.h"
+#include "../include/Parallel_Search.h"
+#include "../include/Search_Stats.h"
+#include <algorithm>
+
+using namespace std;
+
+//--------------------------------------- Position
+
+ConnectFourPosition::ConnectFourPosition(const vector<vector<char>>& b, char to_move) {
+    for (int r = 0; r < HEIGHT; r++)
+        for (int c = 0; c < WIDTH; c++) {
+            if (b[r][c] == '.') continue;
+            uint64_t bit = uint64_t(1) << (c * H1 + HEIGHT - 1 - r);
+            mask |= bit;
+            if (b[r][c] == to_move) current |= bit;
+            moves++;
+        }
+}
+
+bool ConnectFourPosition::opponent_has_four() const {
+    uint64_t position = current ^ mask;
+    for (int shift : {1, H1, HEIGHT, HEIGHT + 2}) {
+        uint64_t pairs = position & (position >> shift);
+        if (pairs & (pairs >> 2 * shift)) return true;
+    }
+    return false;
+}
+
+//--------------------------------------- Transposition table
+
+// Slot layout: key bits 0-31 | value 32-47 | depth 48-55 | bound 56-57 | column + 1 at 58-61.
+// Empty slots are 0, which no stored entry equals (column + 1 is never 0). A slot is loaded and
+// stored as one word, so the threads of a Lazy SMP search see either the old entry or the new one.
+
+void ConnectFourSearch::allocate() {
+    if (slots) return;
+    table = vector<atomic<uint64_t>>(table_size);
+    slots = table.data();
+}
+
+bool ConnectFourSearch::probe(uint64_t key, int& value, int& depth, Bound& bound, int& column) const {
+    uint64_t e = slots[key % table_size].load(memory_order_relaxed);
+    if (e == 0 || static_cast<uint32_t>(e) != static_cast<uint32_t>(key)) return false;
+    value = static_cast<int16_t>(e >> 32);
+    depth = static_cast<int>((e >> 48) & 0xFF);
+    bound = static_cast<Bound>((e >> 56) & 3);
+    column = static_cast<int>((e >> 58) & 0xF) - 1;
+    return true;
+}
+
+void ConnectFourSearch::store(uint64_t key, int value, int depth, Bound bound, int column) {
+    slots[key % table_size].store(static_cast<uint32_t>(key) |
+                                  uint64_t(static_cast<uint16_t>(value)) << 32 |
+                                  uint64_t(depth) << 48 |
+                                  uint64_t(bound) << 56 |
+                                  uint64_t(column + 1) << 58,
+                                  memory_order_relaxed);
+}
+
+//--------------------------------------- Search
+
+int ConnectFourSearch::order_moves(const ConnectFourPosition& p, uint64_t moves_mask, int first_column,
+                                   uint64_t ordered[]) const {
+    static const int CENTRE_FIRST[ConnectFourPosition::WIDTH] = {3, 2, 4, 1, 5, 0, 6};
+    int scores[ConnectFourPosition::WIDTH];
+    int n = 0;
+    for (int c : CENTRE_FIRST) {
+        uint64_t move = moves_mask & p.column_move(c);
+        if (!move) continue;
+        int s = c == first_column ? 1000 : p.threats_after(move);
+        // insertion sort, stable so equal scores stay centre first
+        int k = n++;
+        for (; k > 0 && scores[k - 1] < s; k--) {
+            scores[k] = scores[k - 1];
+            ordered[k] = ordered[k - 1];
+        }
+        scores[k] = s;
+        ordered[k] = move;
+    }
+    return n;
+}
+
+// The side to move cannot win at once (the caller checked, or the move was non-losing)
+int ConnectFourSearch::negamax(const ConnectFourPosition& p, int alpha, int beta, int depth) {
+    SearchCounters& counters = thread_search_counters();
+    counters.nodes++;
+    if (aborted || (*stop)()) {
+        aborted = true;
+        return 0; // result is thrown away with the aborted iteration
+    }
+
+    const int moves = p.get_moves();
+    uint64_t next = p.non_losing_moves();
+    if (!next) return -((ConnectFourPosition::CELLS - moves) / 2) * WIN;
+    if (moves >= ConnectFourPosition::CELLS - 2) return 0; // nobody can complete a four any more
+
+    // Bounds of the score: the opponent cannot win at its next move, we cannot win at this one
+    int lowest = -((ConnectFourPosition::CELLS - 2 - moves) / 2) * WIN;
+    int highest = ((ConnectFourPosition::CELLS - 1 - moves) / 2) * WIN;
+    if (alpha < lowest) {
+        alpha = lowest;
+        if (alpha >= beta) return alpha;
+    }
+    if (beta > highest) {
+        beta = highest;
+        if (alpha >= beta) return beta;
+    }
+    if (depth == 0) {
+        counters.leaves++;
+        int guess = max(-(WIN - 1), min(WIN - 1, p.threat_balance() * 10));
+        return max(lowest, min(highest, guess));
+    }
+    if (depth >= ConnectFourPosition::CELLS - moves) depth = SOLVED;
+
+    const uint64_t key = p.key();
+    int value, stored_depth, column = -1;
+    Bound bound;
+    counters.tt_probes++;
+    if (probe(key, value, stored_depth, bound, column)) {
+        counters.tt_hits++;
+        if (stored_depth >= depth) {
+            if (bound == EXACT) return value;
+            if (bound == LOWER) alpha = max(alpha, value);
+            else beta = min(beta, value);
+            if (alpha >= beta) return value;
+        }
+    }
+
+    uint64_t ordered[ConnectFourPosition::WIDTH];
+    int n = order_moves(p, next, column, ordered);
+    const int alpha0 = alpha;
+    int best = -ConnectFourPosition::CELLS * WIN;
+    int best_column = -1;
+    for (int k = 0; k < n; k++) {
+        ConnectFourPosition child = p;
+        child.play(ordered[k]);
+        int v = -negamax(child, -beta, -alpha, depth - 1);
+        if (aborted) return 0;
+        if (v > best) {
+            best = v;
+            best_column = ConnectFourPosition::column_of(ordered[k]);
+        }
+        alpha = max(alpha, v);
+        if (alpha >= beta) {
+            counters.cutoff(k);
+            break;
+        }
+    }
+
+    store(key, best, depth, best <= alpha0 ? UPPER : (best >= beta ? LOWER : EXACT), best_column);
+    return best;
+}
+
+int ConnectFourSearch::best_column(const ConnectFourPosition& p, const function<bool()>& stop, int max_depth,
+                                   int threads) {
+    this->stop = &stop;
+    helper_counts = SearchCounters();
+    allocate();
+    if (threads <= 1) return search(p, max_depth, 0);
+
+    // Helpers search on this table and give up once the main thread is done
+    atomic<bool> done{false};
+    function<bool()> helper_stop = [&] { return done.load(memory_order_relaxed) || stop(); };
+    vector<unique_ptr<ConnectFourSearch>> helpers;
+    vector<SearchCounters> counted(threads - 1);
+    for (int w = 1; w < threads; w++) {
+        helpers.emplace_back(new ConnectFourSearch(table_size));
+        helpers.back()->slots = slots;
+        helpers.back()->stop = &helper_stop;
+    }
+    int column = run_lazy_smp(threads, done,
+        [&] { return search(p, max_depth, 0); },
+        [&](int w) { count_search(counted[w - 1], [&] { return helpers[w - 1]->search(p, max_depth, w); }); });
+    for (auto& c : counted) helper_counts.add(c);
+    return column;
+}
+
+int ConnectFourSearch::search(const ConnectFourPosition& p, int max_depth, int worker) {
+    aborted = false;
+    depth_reached = 0;
+    score = 0;
+
+    const int moves = p.get_moves();
+    if (!p.possible() || p.opponent_has_four()) return -1;
+
+    depth_reached = 1;
+    if (uint64_t wins = p.winning_moves()) {
+        score = ((ConnectFourPosition::CELLS + 1 - moves) / 2) * WIN;
+        return ConnectFourPosition::column_of(wins & -wins);
+    }
+    uint64_t next = p.non_losing_moves();
+    if (!next) {
+        // Lost whatever we play: block one of the threats, at least
+        score = -((ConnectFourPosition::CELLS - moves) / 2) * WIN;
+        uint64_t blocks = p.possible() & p.opponent_threats();
+        return ConnectFourPosition::column_of(blocks ? blocks & -blocks : p.possible() & -p.possible());
+    }
+
+    uint64_t ordered[ConnectFourPosition::WIDTH];
+    int n = order_moves(p, next, -1, ordered);
+    int best = ConnectFourPosition::column_of(ordered[0]);
+    if (n == 1) return best;
+    depth_reached = 0;
+
+    const int remaining = ConnectFourPosition::CELLS - moves;
+    // Odd helpers search one ply deeper than the main thread, each helper starts with another root move
+    for (int depth = 1 + (worker & 1); depth <= max_depth; depth++) {
+        if (depth >= remaining || depth > HEURISTIC_PLIES) {
+            // Complete search: only the result matters, null windows find it fastest
+            int result = solve_root(p, ordered, n, worker, best);
+            if (aborted) break;
+            score = result;
+            depth_reached = remaining;
+            break;
+        }
+        int alpha = -ConnectFourPosition::CELLS * WIN;
+        int scores[ConnectFourPosition::WIDTH];
+        int iteration_best = 0;
+        for (int i = 0; i < n; i++) {
+            int k = (i + worker) % n;
+            ConnectFourPosition child = p;
+            child.play(ordered[k]);
+            scores[k] = -negamax(child, -ConnectFourPosition::CELLS * WIN, -alpha, depth - 1);
+            if (aborted) break;
+            if (scores[k] > alpha) {
+                alpha = scores[k];
+                iteration_best = k;
+            }
+        }
+        if (aborted) break;
+        best = ConnectFourPosition::column_of(ordered[iteration_best]);
+        score = alpha;
+        depth_reached = depth;
+
+        // Every ply was searched, or the result is proven: deeper iterations would agree
+        if (depth >= remaining || score >= WIN || score <= -WIN) break;
+
+        // Best moves of this iteration first in the next one
+        int order[ConnectFourPosition::WIDTH];
+        for (int k = 0; k < n; k++) order[k] = k;
+        stable_sort(order, order + n, [&](int x, int y) { return scores[x] > scores[y]; });
+        uint64_t sorted[ConnectFourPosition::WIDTH];
+        for (int k = 0; k < n; k++) sorted[k] = ordered[order[k]];
+        copy(sorted, sorted + n, ordered);
+    }
+    return best;
+}
+
+int ConnectFourSearch::solve_root(const ConnectFourPosition& p, const uint64_t ordered[], int n, int first, int& best) {
+    // A winning move, if any (score >= 1 means a win: complete searches only score multiples of WIN)
+    for (int i = 0; i < n; i++) {
+        int k = (i + first) % n;
+        ConnectFourPosition child = p;
+        child.play(ordered[k]);
+        if (-negamax(child, -1, 0, SOLVED) >= 1 && !aborted) {
+            best = ConnectFourPosition::column_of(ordered[k]);
+            return WIN;
+        }
+        if (aborted) return 0;
+    }
+    // Else a drawing one
+    for (int i = 0; i < n; i++) {
+        int k = (i + first) % n;
+        ConnectFourPosition child = p;
+        child.play(ordered[k]);
+        if (-negamax(child, 0, 1, SOLVED) >= 0 && !aborted) {
+            best = ConnectFourPosition::column_of(ordered[k]);
+            return 0;
+        }
+        if (aborted) return 0;
+    }
+    // Every move loses: keep the best of the previous iteration
+    return -WIN;
+}
+
+int ConnectFourSearch::solve(const ConnectFourPosition& p) {
+    static const function<bool()> never = [] { return false; };
+    stop = &never;
+    aborted = false;
+    allocate();
+    if (p.can_win_next()) return ((ConnectFourPosition::CELLS + 1 - p.get_moves()) / 2) * WIN;
+    return negamax(p, -ConnectFourPosition::CELLS * WIN, ConnectFourPosition::CELLS * WIN, SOLVED);
+}
@@ -37,82 +37,27 @@ bool Diamond_Tic_Tac_Toe_Board::update_board(Move<char>* move) {
 
         if (mark == 0) { // Undo move
             n_moves--;
+            int side = BitBoard::xo_side(board[x][y]);
+            if (side >= 0) sides[side] &= ~diamond_bit(x, y);
             board[x][y] = blank_symbol;
         } else {         // Apply move
             n_moves++;
             board[x][y] = toupper(mark);
+            int side = BitBoard::xo_side(board[x][y]);
+            if (side >= 0) sides[side] |= diamond_bit(x, y);
         }
         return true;
     }
     return false;
 }
 
-bool Diamond_Tic_Tac_Toe_Board::is_win(Player<char>* player) {
-    char sym = player->get_symbol();
-
-    // Variables to store the maximum consecutive sequence found in each direction
-    int max_row = 0;   // Horizontal
-    int max_col = 0;   // Vertical
-    int max_diag1 = 0; // Main Diagonal (Top-Left to Bottom-Right)
-    int max_diag2 = 0; // Anti-Diagonal (Top-Right to Bottom-Left)
-
-    // Iterate over every cell in the board
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < columns; j++) {
-
-            // If the cell does not belong to the current player, skip it
-            if (board[i][j] != sym) continue;
-
-            // 1. Check Horizontal (Row)
-            int current_row = 0;
-            for (int k = 0; k < 7; k++) {
-                if (j + k < columns && board[i][j + k] == sym) current_row++;
-                else break;
-            }
-            if (current_row > max_row) max_row = current_row;
-
-            // 2. Check Vertical (Column)
-            int current_col = 0;
-            for (int k = 0; k < 7; k++) {
-                if (i + k < rows && board[i + k][j] == sym) current_col++;
-                else break;
-            }
-            if (current_col > max_col) max_col = current_col;
-
-            // 3. Check Main Diagonal
-            int current_diag1 = 0;
-            for (int k = 0; k < 7; k++) {
-                if (i + k < rows && j + k < columns && board[i + k][j + k] == sym) current_diag1++;
-                else break;
-            }
-            if (current_diag1 > max_diag1) max_diag1 = current_diag1;
-
-            // 4. Check Anti-Diagonal
-            int current_diag2 = 0;
-            for (int k = 0; k < 7; k++) {
-                if (i + k < rows && j - k >= 0 && board[i + k][j - k] == sym) current_diag2++;
-                else break;
-            }
-            if (current_diag2 > max_diag2) max_diag2 = current_diag2;
-        }
-    }
+bool Diamond_Tic_Tac_Toe_Board::is_win(char symbol) {
+    int side = BitBoard::xo_side(symbol);
+    if (side < 0) return false;
 
     // Win Condition: One line of length >= 4 AND another line of length >= 3
     // The two lines must be in DIFFERENT directions.
-
-    // Case 1: Primary line (4) is Horizontal. Secondary (3) must be Vertical or Diagonal.
-    if (max_row >= 4 && (max_col >= 3 || max_diag1 >= 3 || max_diag2 >= 3)) return true;
-
-    // Case 2: Primary line (4) is Vertical. Secondary (3) must be Horizontal or Diagonal.
-    if (max_col >= 4 && (max_row >= 3 || max_diag1 >= 3 || max_diag2 >= 3)) return true;
-
-    // Case 3: Primary line (4) is Main Diagonal. Secondary (3) must be Row, Col, or Anti-Diag.
-    if (max_diag1 >= 4 && (max_row >= 3 || max_col >= 3 || max_diag2 >= 3)) return true;
-
-    // Case 4: Primary line (4) is Anti-Diagonal. Secondary (3) must be Row, Col, or Main Diag.
-    if (max_diag2 >= 4 && (max_row >= 3 || max_col >= 3 || max_diag1 >= 3)) return true;
-
-    return false;
+    return DiamondBits::is_win(sides[side]);
 }
 
 bool Diamond_Tic_Tac_Toe_Board::is_draw(Player<char>* player) {
@@ -123,137 +68,64 @@ bool Diamond_Tic_Tac_Toe_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
-
-char DiamondSmartPlayer::get_opponent_symbol() const {
-    return (this->symbol == 'X') ? 'O' : 'X';
+// Everything a position needs; the masks are rebuilt from the cells
+struct DiamondState {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("DIAM");
+    char cells[7][7];
+    int n_moves;
+};
+
+bool Diamond_Tic_Tac_Toe_Board::snapshot(BoardSnapshot& s) const {
+    DiamondState st;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    s.store(st);
+    return true;
 }
 
+bool Diamond_Tic_Tac_Toe_Board::restore(const BoardSnapshot& s) {
+    DiamondState st;
+    if (!s.load(st)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    sides[0] = DiamondBits::from_matrix(board, 'X');
+    sides[1] = DiamondBits::from_matrix(board, 'O');
+    return true;
+}
 
-bool DiamondSmartPlayer::is_win(const vector<vector<char>>& b, char symbol, int N) const {
-    int rows = b.size();
-    int cols = b[0].size();
-
-    int max_row = 0;   // Horizontal
-    int max_col = 0;   // Vertical
-    int max_diag1 = 0; // Main Diagonal
-    int max_diag2 = 0; // Anti-Diagonal
-
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            if (b[i][j] != symbol) continue;
-
-            // 1. Horizontal
-            int current = 0;
-            for (int k = 0; k < 7; k++) {
-                if (j + k < cols && b[i][j + k] == symbol) current++;
-                else break;
-            }
-            max_row = max(max_row, current);
-
-            // 2. Vertical
-            current = 0;
-            for (int k = 0; k < 7; k++) {
-                if (i + k < rows && b[i + k][j] == symbol) current++;
-                else break;
-            }
-            max_col = max(max_col, current);
-
-            // 3. Diagonal 1
-            current = 0;
-            for (int k = 0; k < 7; k++) {
-                if (i + k < rows && j + k < cols && b[i + k][j + k] == symbol) current++;
-                else break;
-            }
-            max_diag1 = max(max_diag1, current);
-
-            // 4. Diagonal 2
-            current = 0;
-            for (int k = 0; k < 7; k++) {
-                if (i + k < rows && j - k >= 0 && b[i + k][j - k] == symbol) current++;
-                else break;
-            }
-            max_diag2 = max(max_diag2, current);
-        }
-    }
-
-    if (max_row >= 4 && (max_col >= 3 || max_diag1 >= 3 || max_diag2 >= 3)) return true;
-    if (max_col >= 4 && (max_row >= 3 || max_diag1 >= 3 || max_diag2 >= 3)) return true;
-    if (max_diag1 >= 4 && (max_row >= 3 || max_col >= 3 || max_diag2 >= 3)) return true;
-    if (max_diag2 >= 4 && (max_row >= 3 || max_col >= 3 || max_diag1 >= 3)) return true;
 
-    return false;
+char DiamondSmartPlayer::get_opponent_symbol() const {
+    return (this->symbol == 'X') ? 'O' : 'X';
 }
 
 
-int DiamondSmartPlayer::evaluate_board(const vector<vector<char>>& b, char ai, char opp, int N) const {
+bool DiamondSmartPlayer::is_win(const vector<vector<char>>& b, char symbol, int /*N*/) const {
+    return DiamondBits::is_win(DiamondBits::from_matrix(b, symbol));
+}
 
 
-    int position_weights[7][7] = {
-        {0, 0, 0, 1, 0, 0, 0},
-        {0, 0, 2, 3, 2, 0, 0},
-        {0, 2, 4, 5, 4, 2, 0},
-        {1, 3, 5, 8, 5, 3, 1},
-        {0, 2, 4, 5, 4, 2, 0},
-        {0, 0, 2, 3, 2, 0, 0},
-        {0, 0, 0, 1, 0, 0, 0}
-    };
+int DiamondSmartPlayer::evaluate_board(const vector<vector<char>>& b, char ai, char opp, int /*N*/) const {
+    return evaluate_bits(DiamondBits::from_matrix(b, ai), DiamondBits::from_matrix(b, opp));
+}
 
+int DiamondSmartPlayer::evaluate_bits(uint64_t ai, uint64_t opp) {
+    // Positional weights, centre first (see diamond_masks())
     int score = 0;
-    int rows = b.size();
-    int cols = b[0].size();
-
-    for(int i=0; i<rows; i++) {
-        for(int j=0; j<cols; j++) {
-            if (b[i][j] == ai) score += position_weights[i][j];
-            else if (b[i][j] == opp) score -= position_weights[i][j];
-        }
-    }
-
-
-    auto analyze_player = [&](char symbol) -> int {
-        int max_h = 0, max_v = 0, max_d1 = 0, max_d2 = 0;
-
-
-        for(int i=0; i<rows; i++) {
-            for(int j=0; j<cols; j++) {
-                if(b[i][j] != symbol) continue;
-
-                // Horizontal
-                int cnt = 0;
-                for(int k=0; k<7; k++) { if(j+k<cols && b[i][j+k]==symbol) cnt++; else break; }
-                max_h = max(max_h, cnt);
-
-                // Vertical
-                cnt = 0;
-                for(int k=0; k<7; k++) { if(i+k<rows && b[i+k][j]==symbol) cnt++; else break; }
-                max_v = max(max_v, cnt);
+    for (int w = 1; w <= 8; w++)
+        score += w * (__builtin_popcountll(ai & DIAMOND_MASKS.weights[w]) -
+                      __builtin_popcountll(opp & DIAMOND_MASKS.weights[w]));
 
-                // Diag 1
-                cnt = 0;
-                for(int k=0; k<7; k++) { if(i+k<rows && j+k<cols && b[i+k][j+k]==symbol) cnt++; else break; }
-                max_d1 = max(max_d1, cnt);
-
-                // Diag 2
-                cnt = 0;
-                for(int k=0; k<7; k++) { if(i+k<rows && j-k>=0 && b[i+k][j-k]==symbol) cnt++; else break; }
-                max_d2 = max(max_d2, cnt);
-            }
-        }
-
-        int p_score = 0;
-
-
-        vector<int> lines = {max_h, max_v, max_d1, max_d2};
-        sort(lines.rbegin(), lines.rend());
+    auto analyze_player = [&](uint64_t side) -> int {
+        int lines[4];
+        for (int d = 0; d < 4; d++) lines[d] = DiamondBits::longest_run(side, d);
+        sort(lines, lines + 4, greater<int>());
 
         int best = lines[0];
         int second_best = lines[1];
-
-
+        int p_score = 0;
 
         if (best >= 4 && second_best >= 3) return 100000;
 
-
         if (best >= 4) p_score += 2000 + (second_best * 100);
 
         if (best == 3) p_score += 500 + (second_best * 50);
@@ -269,45 +141,149 @@ int DiamondSmartPlayer::evaluate_board(const vector<vector<char>>& b, char ai, c
     return score;
 }
 
-pair<int, int> DiamondSmartPlayer::calculateMove() {
-    Board<char>* board_ptr = this->get_board_ptr();
-    auto tempBoard = board_ptr->get_board_matrix();
-
-    char ai = this->get_symbol();
-    char opp = get_opponent_symbol();
-
-    int bestVal = numeric_limits<int>::min();
-    int bestX = -1, bestY = -1;
-
-    int maxDepth = 3;
-
-    for (int i = 0; i < 7; i++) {
-        for (int j = 0; j < 7; j++) {
-            if (tempBoard[i][j] == '.' && abs(i - 3) + abs(j - 3) <= 3) {
-
-                tempBoard[i][j] = ai;
-
-
-                int moveVal = minimax(tempBoard, false, ai, opp,
-                                      numeric_limits<int>::min(),
-                                      numeric_limits<int>::max(),
-                                      maxDepth);
+int DiamondSmartPlayer::move_prior(int x, int y, int /*rows*/, int /*cols*/) const {
+    for (int w = 1; w <= 8; w++)
+        if (DIAMOND_MASKS.weights[w] & diamond_bit(x, y)) return w;
+    return 0;
+}
 
-                tempBoard[i][j] = '.';
+/// Rotations and reflections of the 7x7 grid, all of which map the diamond onto itself.
+static const MaskSymmetry DIAMOND_SYMMETRY(7);
+
+pair<int,int> DiamondSmartPlayer::search_best_move(vector<vector<char>>& b) {
+    search_counts = SearchCounters();
+    search_plies = 0;
+    uint64_t ai = DiamondBits::from_matrix(b, symbol);
+    uint64_t opp = DiamondBits::from_matrix(b, get_opponent_symbol());
+    if (!(DIAMOND_MASKS.cells & ~(ai | opp))) return {-1, -1};
+
+    start_search_clock();
+    start_move_ordering(b);
+    table.new_search();
+    int threads = resolve_search_threads(search_threads);
+    vector<SearchCounters> counted(threads);
+    // Helpers stop on the deadline, or through search_aborted once the main thread is done
+    int cell = run_lazy_smp(threads, search_aborted,
+        [&] { return count_search(counted[0], [&] { return deepen(ai, opp, 0); }); },
+        [&](int worker) { count_search(counted[worker], [&] { return deepen(ai, opp, worker); }); });
+
+    for (auto& c : counted) search_counts.add(c);
+    if (cell < 0) {
+        // Not even the first iteration finished: any empty cell, centre first
+        uint64_t empty = DIAMOND_MASKS.cells & ~(ai | opp);
+        for (int w = 8; w >= 1 && cell < 0; w--)
+            if (uint64_t m = empty & DIAMOND_MASKS.weights[w]) cell = __builtin_ctzll(m);
+    }
+    return {cell / 7, cell % 7};
+}
 
-                if (moveVal > bestVal) {
-                    bestVal = moveVal;
-                    bestX = i;
-                    bestY = j;
-                }
+int DiamondSmartPlayer::deepen(uint64_t ai, uint64_t opp, int worker) {
+    uint64_t empty = DIAMOND_MASKS.cells & ~(ai | opp);
+    const int empties = __builtin_popcountll(empty);
+    int moves[25], scores[25];
+    int n = 0;
+    for (uint64_t cells = empty; cells; cells &= cells - 1) moves[n++] = __builtin_ctzll(cells);
+    move_ordering().order(moves, n, MoveOrdering::MAX_DEPTH);
+
+    int best = -1;
+    // Odd helpers search one ply deeper than the main thread, at the same time
+    for (int depth = worker & 1; depth < max_search_depth; depth++) {
+        int alpha = numeric_limits<int>::min();
+        int iteration_best = -1;
+        for (int i = 0; i < n; i++) {
+            int k = (i + worker) % n; // each helper starts with another move
+            scores[k] = minimax_bits(ai | uint64_t(1) << moves[k], opp, false, alpha,
+                                     numeric_limits<int>::max(), depth);
+            if (search_aborted) break;
+            if (scores[k] > alpha || iteration_best < 0) {
+                alpha = scores[k];
+                iteration_best = k;
             }
         }
+        if (search_aborted) break;
+        best = moves[iteration_best];
+        if (worker == 0) search_plies = depth + 1;
+
+        // Stop early once a win is proven (WIN_SCORE + remaining depth) or every remaining ply was searched
+        if ((alpha >= WIN_SCORE && alpha <= WIN_SCORE + depth) || depth + 1 >= empties) break;
+
+        // Best moves of this iteration first in the next one
+        int order[25];
+        for (int k = 0; k < n; k++) order[k] = k;
+        stable_sort(order, order + n, [&](int x, int y) { return scores[x] > scores[y]; });
+        int sorted[25];
+        for (int k = 0; k < n; k++) sorted[k] = moves[order[k]];
+        copy(sorted, sorted + n, moves);
     }
-    return {bestX, bestY};
+    return best;
 }
 
+int DiamondSmartPlayer::minimax_bits(uint64_t ai, uint64_t opp, bool maximizingPlayer, int alpha, int beta, int depth) {
+    if (time_up()) return 0; // result is thrown away with the aborted iteration
+    SearchCounters& counters = thread_search_counters();
+    counters.nodes++;
+    if (DiamondBits::is_win(ai)) return WIN_SCORE + depth; // prefer faster win
+    if (DiamondBits::is_win(opp)) return -WIN_SCORE - depth; // prefer slower loss
+    uint64_t empty = DIAMOND_MASKS.cells & ~(ai | opp);
+    if (!empty) return 0;
+    if (depth == 0) {
+        counters.leaves++;
+        return evaluate_bits(ai, opp);
+    }
+
+    // Transposition table on the canonical form: its moves are brought back through the symmetry
+    int symmetry;
+    uint64_t key = DIAMOND_SYMMETRY.canonical_key(ai, opp, symmetry) ^ (maximizingPlayer ? 0 : 1);
+    int alphaOrig = alpha, betaOrig = beta;
+    int ttMove = -1;
+    TTEntry entry;
+    counters.tt_probes++;
+    if (table.probe(key, entry)) {
+        counters.tt_hits++;
+        if (entry.best_move >= 0)
+            ttMove = DIAMOND_SYMMETRY.cell(BoardSymmetry::inverse(symmetry), entry.best_move);
+        if (entry.depth >= depth) {
+            int value = TableScore::from_table(entry.value, depth, WIN_SCORE);
+            if (entry.flag == BoundType::EXACT) return value;
+            if (entry.flag == BoundType::LOWER) alpha = max(alpha, value);
+            else beta = min(beta, value);
+            if (beta <= alpha) return value;
+        }
+    }
 
+    // Cells are numbered like the bits (x * 7 + y), as move_priors expects for a 7x7 board
+    int moves[25];
+    int n = 0;
+    for (uint64_t cells = empty; cells; cells &= cells - 1) moves[n++] = __builtin_ctzll(cells);
+    MoveOrdering& ordering = move_ordering();
+    ordering.order(moves, n, depth, ttMove);
+
+    int best = maximizingPlayer ? numeric_limits<int>::min() : numeric_limits<int>::max();
+    int bestMove = -1;
+    for (int k = 0; k < n; k++) {
+        uint64_t move = uint64_t(1) << moves[k];
+        int val = maximizingPlayer ? minimax_bits(ai | move, opp, false, alpha, beta, depth - 1)
+                                   : minimax_bits(ai, opp | move, true, alpha, beta, depth - 1);
+        if (maximizingPlayer ? val > best : val < best) {
+            best = val;
+            bestMove = moves[k];
+        }
+        if (maximizingPlayer) alpha = max(alpha, best);
+        else beta = min(beta, best);
+        if (beta <= alpha) {
+            counters.cutoff(k);
+            ordering.cutoff(moves[k], depth);
+            break;
+        }
+    }
 
+    if (!search_aborted) {
+        BoundType flag = best <= alphaOrig ? BoundType::UPPER
+                       : best >= betaOrig ? BoundType::LOWER : BoundType::EXACT;
+        table.store(key, depth, TableScore::to_table(best, depth, WIN_SCORE), flag, DIAMOND_SYMMETRY.cell(symmetry, bestMove));
+    }
+    return best;
+}
 
 //--------------------------------------- UI Implementation
 
@@ -318,7 +294,7 @@ Player<char>* Diamond_Tic_Tac_Toe_UI::create_player(string& name, char symbol, P
          << " player: " << name << " (" << symbol << ")\n";
 
     if (type == PlayerType::COMPUTER)
-        return new smartPlayer<char>(name, symbol, type);   // create smartPlayer
+        return new DiamondSmartPlayer(name, symbol, type);  // create smartPlayer
 
     return new Player<char>(name, symbol, type);            // human is regular player
 }
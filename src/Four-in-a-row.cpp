@@ -1,5 +1,6 @@
 #include "../include/Four-in-a-row.h"
 #include "../include/Smart_Player.h"
+#include "../include/Connect_Four.h"
 #include <bits/stdc++.h>
 
 using namespace std;
@@ -10,6 +11,9 @@ public:
     smartPlayer2(string n, char s, PlayerType t)
             : smartPlayer<char>(n, s, t) {}
 
+    // The pondering thread searches with engine: stop it before the engine goes
+    ~smartPlayer2() override { stop_pondering(); }
+
     int evaluate_board(const vector<vector<char>>& b, char ai, char opp, int N = 4) const override {
         return smartPlayer<char>::evaluate_board(b, ai, opp, N);
     }
@@ -22,87 +26,53 @@ public:
         return smartPlayer<char>::is_draw(b, N);
     }
 
-    int minimax(vector<vector<char>>& b, bool maximizingPlayer, char ai, char opp, int alpha, int beta, int depth, int N = 4) {
-        if (is_win(b, ai, N)) return 1000 + depth; // prefer faster win
-        if (is_win(b, opp, N)) return -1000 - depth; // prefer slower loss
-        if (is_draw(b, N)) return 0;
-        if (depth == 0) return evaluate_board(b, ai, opp, N);
+    int win_length() const override { return 4; }
 
+    // Pieces drop: the only playable cell of a column is its lowest empty one
+    vector<pair<int,int>> generate_moves(const vector<vector<char>>& b) const override {
+        vector<pair<int,int>> moves;
         int rows = b.size();
         int cols = b[0].size();
-
-        if (maximizingPlayer) {
-            int best = numeric_limits<int>::min();
-            for (int j = 0; j < cols; j++)
-                for (int i = rows-1; i >= 0; i--)
-                    if (b[i][j] == '.') {
-                        b[i][j] = ai;
-                        int val = minimax(b, false, ai, opp, alpha, beta, depth - 1, N);
-                        b[i][j] = '.';
-                        best = max(best, val);
-                        alpha = max(alpha, best);
-                        if (beta <= alpha) return best;
-                    }
-            return best;
-        } else {
-            int best = numeric_limits<int>::max();
-            for (int j = 0; j < cols; j++)
-                for (int i = rows-1; i >= 0; i--)
-                    if (b[i][j] == '.') {
-                        b[i][j] = opp;
-                        int val = minimax(b, true, ai, opp, alpha, beta, depth - 1, N);
-                        b[i][j] = '.';
-                        best = min(best, val);
-                        beta = min(beta, best);
-                        if (beta <= alpha) return best;
-                    }
-            return best;
-        }
-    }
-
-    pair<int,int> calculateMove()  {
-        Board<char>* board_ptr = this->get_board_ptr();
-        if (!board_ptr) throw runtime_error("Board not assigned to player!");
-
-        auto tempBoard = board_ptr->get_board_matrix();
-        int rows = tempBoard.size();
-        int cols = tempBoard[0].size();
-
-        int bestVal = numeric_limits<int>::min();
-        int bestX = -1, bestY = -1;
-
-        char ai = this->get_symbol();
-        char opp = get_opponent_symbol();
-
-        int maxDepth = 2; // tweak: higher depth = stronger AI but slower
-
         for (int j = 0; j < cols; j++)
             for (int i = rows-1; i >= 0; i--)
-                if (tempBoard[i][j] == '.') {
-                    tempBoard[i][j] = ai;
-                    int moveVal = minimax(tempBoard, false, ai, opp,
-                                          numeric_limits<int>::min(),
-                                          numeric_limits<int>::max(),
-                                          maxDepth);
-                    tempBoard[i][j] = '.';
-                    if (moveVal > bestVal) {
-                        bestVal = moveVal;
-                        bestX = i;
-                        bestY = j;
-                    }
+                if (b[i][j] == '.') {
+                    moves.push_back({i, j});
+                    break;
                 }
+        return moves;
+    }
 
-        return {bestX, bestY};
+    // The bitboard engine replaces the generic search; the matrix hooks above still serve pondering.
+    // search_threads runs it as a Lazy SMP search (helpers share its table) instead of a root split
+    pair<int,int> search_best_move(vector<vector<char>>& b) override {
+        search_counts = SearchCounters();
+        search_plies = 0;
+        ConnectFourPosition position(b, get_symbol());
+        start_search_clock();
+        function<bool()> stop = [this] { return time_up(); };
+        int threads = resolve_search_threads(search_threads);
+        int column = count_search(search_counts, [&] {
+            return engine.best_column(position, stop, max_search_depth, threads);
+        });
+        search_counts.add(engine.helper_counters());
+        search_plies = engine.last_depth();
+        if (column < 0) return {-1, -1};
+        int row = (int)b.size() - 1;
+        while (b[row][column] != '.') row--;
+        return {row, column};
     }
 
+private:
+    ConnectFourSearch engine; // its table is kept from move to move
 };
 
 
-Four_in_a_row_Board::Four_in_a_row_Board() : Board(6, 7) {
+Four_in_a_row_Board::Four_in_a_row_Board() : Board(6, 7), lines(6, 7) {
     // Initialize all cells with blank_symbol
     for (auto& row : board)
         for (auto& cell : row)
             cell = blank_symbol;
+    lines.add_all_runs(4);
 }
 
 bool Four_in_a_row_Board::update_board(Move<char>* move) {
@@ -117,6 +87,8 @@ bool Four_in_a_row_Board::update_board(Move<char>* move) {
         if (board[r][col] == blank_symbol) {
             board[r][col] = sym;
             n_moves++;
+            int side = BitBoard::xo_side(sym);
+            if (side >= 0) lines.place(r, col, side);
             return true;
         }
     }
@@ -124,44 +96,8 @@ bool Four_in_a_row_Board::update_board(Move<char>* move) {
 }
 
 
-bool Four_in_a_row_Board::is_win(Player<char>* player) {
-
-    char sym = player->get_symbol();
-
-    //Rows
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < columns - 3; j++) {
-            if (board[i][j] == sym && board[i][j+1] == sym && board[i][j+2] == sym && board[i][j+3] == sym)
-                return true;
-        }
-    }
-
-    // Columns
-    for (int j = 0; j < columns; j++) {
-        for (int i = 0; i < rows - 3; i++) {
-            if (board[i][j] == sym && board[i+1][j] == sym && board[i+2][j] == sym && board[i+3][j] == sym)
-                return true;
-        }
-    }
-
-    // Main diagonal
-    for (int i = 0; i < rows - 3; i++) {
-        for (int j = 0; j < columns - 3; j++) {
-            if (board[i][j] == sym && board[i+1][j+1] == sym && board[i+2][j+2] == sym && board[i+3][j+3] == sym)
-                return true;
-        }
-    }
-
-    //  Anti diagonal
-    for (int i = 0; i < rows - 3; i++) {
-        for (int j = 3; j < columns; j++) {
-            if (board[i][j] == sym && board[i+1][j-1] == sym && board[i+2][j-2] == sym && board[i+3][j-3] == sym)
-                return true;
-        }
-    }
-
-    return false;
-
+bool Four_in_a_row_Board::is_win(char symbol) {
+    return lines.has_line(BitBoard::xo_side(symbol));
 }
 
 bool Four_in_a_row_Board::is_draw(Player<char> *player) {
@@ -173,6 +109,30 @@ bool Four_in_a_row_Board::game_is_over(Player<char> *player) {
     return  (is_win(player) || is_draw(player));
 }
 
+// Everything a position needs; the line counts are rebuilt from the cells
+struct FourInARowState {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("FIAR");
+    char cells[6][7];
+    int n_moves;
+};
+
+bool Four_in_a_row_Board::snapshot(BoardSnapshot& s) const {
+    FourInARowState st;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    s.store(st);
+    return true;
+}
+
+bool Four_in_a_row_Board::restore(const BoardSnapshot& s) {
+    FourInARowState st;
+    if (!s.load(st)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    lines.rebuild(board, BitBoard::xo_side);
+    return true;
+}
+
 
 Four_in_a_row_UI::Four_in_a_row_UI() : UI<char>("Weclome to FCAI Four_in_a_row Game by Adham", 3) {}
 
@@ -182,7 +142,7 @@ Player<char>* Four_in_a_row_UI::create_player(string& name, char symbol, PlayerT
         << " player: " << name << " (" << symbol << ")\n";
 
     if (type == PlayerType::HUMAN) return new Player<char>(name, symbol, type);
-    return new smartPlayer<char>(name, symbol, type);
+    return new smartPlayer2(name, symbol, type);
 }
 
 Move<char>* Four_in_a_row_UI::get_move(Player<char>* player) {
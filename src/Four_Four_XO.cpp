@@ -6,7 +6,7 @@
 #include "../include/Four_Four_XO.h"
 
 
-Four_Four_XO_Board::Four_Four_XO_Board(): Board(4, 4) {
+Four_Four_XO_Board::Four_Four_XO_Board(): Board(4, 4), lines(4, 4) {
     // Initialize all cells with blank_symbol
     for (auto& row : board)
         for (auto& cell : row)
@@ -16,6 +16,18 @@ Four_Four_XO_Board::Four_Four_XO_Board(): Board(4, 4) {
         board[0][i] = 'X'; board[0][i+1] = 'O';
         board[3][i] = 'O'; board[3][i+1] = 'X';
     }
+
+    // Winning lines: the first three cells of every row and column, and the two 3x3 diagonals
+    for (int i = 0; i < 4; i++) {
+        lines.add_line({{i, 0}, {i, 1}, {i, 2}});
+        lines.add_line({{0, i}, {1, i}, {2, i}});
+    }
+    lines.add_line({{0, 0}, {1, 1}, {2, 2}});
+    lines.add_line({{0, 2}, {1, 1}, {2, 0}});
+
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < columns; j++)
+            if (board[i][j] != blank_symbol) lines.place(i, j, BitBoard::xo_side(board[i][j]));
 }
 
 
@@ -36,29 +48,17 @@ bool Four_Four_XO_Board::update_board(Move<char> *move) {
     n_moves++;
     board[x][y] = blank_symbol;
     board[x+dx][y+dy] = symbol;
-    return true;
-}
-
-bool Four_Four_XO_Board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
 
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-    };
-
-    // Check rows and columns
-    for (int i = 0; i < rows; ++i) {
-        if ((all_equal(board[i][0], board[i][1], board[i][2]) && board[i][0] == sym) ||
-            (all_equal(board[0][i], board[1][i], board[2][i]) && board[0][i] == sym))
-            return true;
+    int side = BitBoard::xo_side(symbol);
+    if (side >= 0) {
+        lines.remove(x, y, side);
+        lines.place(x+dx, y+dy, side);
     }
+    return true;
+}
 
-    // Check diagonals
-    if ((all_equal(board[0][0], board[1][1], board[2][2]) && board[1][1] == sym) ||
-        (all_equal(board[0][2], board[1][1], board[2][0]) && board[1][1] == sym))
-        return true;
-
-    return false;
+bool Four_Four_XO_Board::is_win(char symbol) {
+    return lines.has_line(BitBoard::xo_side(symbol));
 }
 
 bool Four_Four_XO_Board::is_draw(Player<char>* player) {
@@ -69,6 +69,30 @@ bool Four_Four_XO_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+// Everything a position needs; the line counts are rebuilt from the cells
+struct FourFourState {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("FF4X");
+    char cells[4][4];
+    int n_moves;
+};
+
+bool Four_Four_XO_Board::snapshot(BoardSnapshot& s) const {
+    FourFourState st;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    s.store(st);
+    return true;
+}
+
+bool Four_Four_XO_Board::restore(const BoardSnapshot& s) {
+    FourFourState st;
+    if (!s.load(st)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    lines.rebuild(board, BitBoard::xo_side);
+    return true;
+}
+
 
 //=========Four-Four Tic Tac Toe UI Implementation =========
 
@@ -0,0 +1,225 @@
+//
+// Created by abdelhamid on 12/20/25.
+//
+
+#include "../include/Game_Record.h"
+#include "../include/Numerical_X_O.h"
+#include "../include/Words_XO.h"
+#include "../include/SUS_Classes.h"
+#include "../include/Four_Four_XO.h"
+#include "../include/Obstacles_XO.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+using namespace std;
+
+static const char RECORD_MAGIC[8] = {'B', 'G', 'F', 'G', 'R', '0', '0', '1'};
+
+static void put_varint(string& bytes, uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<char>(value));
+}
+
+//--------------------------------------- Moves
+
+RecordedMove recorded_move(const Move<char>& move, RecordedMoveType& type) {
+    RecordedMove m;
+    m.x = static_cast<uint8_t>(move.get_x());
+    m.y = static_cast<uint8_t>(move.get_y());
+    if (auto n = dynamic_cast<const nMove*>(&move)) {
+        type = RecordedMoveType::NUMBER;
+        m.value = n->get_value();
+    } else if (auto w = dynamic_cast<const neMove*>(&move)) {
+        type = RecordedMoveType::LETTER;
+        m.value = w->get_value();
+    } else if (auto s = dynamic_cast<const ne_Move*>(&move)) {
+        type = RecordedMoveType::SUS;
+        m.value = s->get_value();
+    } else if (auto d = dynamic_cast<const dualMove*>(&move)) {
+        type = RecordedMoveType::SLIDE;
+        m.dx = static_cast<int8_t>(d->get_dx());
+        m.dy = static_cast<int8_t>(d->get_dy());
+    }
+    return m;
+}
+
+RecordedMoveType recorded_move_type(const Board<char>& board) {
+    if (dynamic_cast<const Numerical_X_O_Board*>(&board)) return RecordedMoveType::NUMBER;
+    if (dynamic_cast<const Word_XO_Board*>(&board)) return RecordedMoveType::LETTER;
+    if (dynamic_cast<const SUS_Board*>(&board)) return RecordedMoveType::SUS;
+    if (dynamic_cast<const Four_Four_XO_Board*>(&board)) return RecordedMoveType::SLIDE;
+    return RecordedMoveType::PLAIN;
+}
+
+//--------------------------------------- GameRecord
+
+Move<char>* GameRecord::make_move(RecordedMoveType type, const RecordedMove& m, char symbol) {
+    switch (type) {
+        case RecordedMoveType::NUMBER: return new nMove(m.x, m.y, symbol, m.value);
+        case RecordedMoveType::LETTER: return new neMove(m.x, m.y, symbol, m.value);
+        case RecordedMoveType::SUS:    return new ne_Move(m.x, m.y, symbol, m.value);
+        case RecordedMoveType::SLIDE:  return new dualMove(m.x, m.y, symbol, m.dy, m.dx);
+        default:                       return new Move<char>(m.x, m.y, symbol);
+    }
+}
+
+bool GameRecord::replay(Board<char>& board) const {
+    auto obstacles = dynamic_cast<Obstacles_XO_Board*>(&board);
+    size_t placed = 0;
+    for (size_t i = 0; i < moves.size(); i++) {
+        // Cells the board fills after the move come from the record, not from rand()
+        for (int k = 0; k < moves[i].placed && placed < placed_cells.size(); k++, placed++)
+            if (obstacles) obstacles->queue_obstacle(placed_cells[placed] / columns, placed_cells[placed] % columns);
+        unique_ptr<Move<char>> move(make_move(i));
+        if (!board.update_board(move.get())) return false;
+    }
+    return true;
+}
+
+//--------------------------------------- Writer
+
+GameRecordWriter::GameRecordWriter(const string& path) : out(path, ios::binary | ios::app) {
+    if (out.is_open() && out.tellp() == 0) out.write(RECORD_MAGIC, sizeof(RECORD_MAGIC));
+}
+
+void GameRecordWriter::encode(const GameRecord& record, string& bytes) {
+    put_varint(bytes, record.game_id);
+    for (auto& name : record.players) {
+        size_t length = min(name.size(), GameRecord::MAX_NAME_LENGTH);
+        put_varint(bytes, length);
+        bytes.append(name, 0, length);
+    }
+    bytes.push_back(static_cast<char>(record.rows));
+    bytes.push_back(static_cast<char>(record.columns));
+    bytes.push_back(static_cast<char>(record.move_type));
+    bytes.push_back(static_cast<char>(record.result));
+    put_varint(bytes, record.moves.size());
+    size_t placed = 0;
+    for (auto& m : record.moves) {
+        put_varint(bytes, (m.x * record.columns + m.y) * 2 + (m.placed > 0));
+        switch (record.move_type) {
+            case RecordedMoveType::PLAIN: break;
+            case RecordedMoveType::SLIDE: bytes.push_back(static_cast<char>((m.dx + 1) * 3 + (m.dy + 1))); break;
+            default:                      bytes.push_back(m.value); break;
+        }
+        if (m.placed == 0) continue;
+        put_varint(bytes, m.placed);
+        for (int k = 0; k < m.placed; k++) put_varint(bytes, record.placed_cells[placed++]);
+    }
+}
+
+void GameRecordWriter::write(const GameRecord& record) {
+    // Encode outside the lock, a record is written in one piece
+    string bytes;
+    encode(record, bytes);
+    lock_guard<mutex> guard(lock);
+    out.write(bytes.data(), bytes.size());
+}
+
+//--------------------------------------- Reader
+
+GameRecordReader::GameRecordReader(const string& path) : in(path, ios::binary) {
+    char magic[8];
+    valid = in.read(magic, sizeof(magic)) && memcmp(magic, RECORD_MAGIC, sizeof(magic)) == 0;
+}
+
+bool GameRecordReader::read_varint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = in.get();
+        if (c == EOF) return false;
+        value |= static_cast<uint64_t>(c & 0x7F) << shift;
+        if (!(c & 0x80)) return true;
+    }
+    return false;
+}
+
+bool GameRecordReader::next(GameRecord& record) {
+    if (!valid) return false;
+    uint64_t value;
+    if (!read_varint(value)) return false;
+    record.game_id = static_cast<uint32_t>(value);
+    for (auto& name : record.players) {
+        if (!read_varint(value) || value > GameRecord::MAX_NAME_LENGTH) return false;
+        name.resize(value);
+        if (!in.read(&name[0], value)) return false;
+    }
+
+    char fields[4];
+    if (!in.read(fields, sizeof(fields))) return false;
+    record.rows = static_cast<uint8_t>(fields[0]);
+    record.columns = static_cast<uint8_t>(fields[1]);
+    record.move_type = static_cast<RecordedMoveType>(fields[2]);
+    record.result = static_cast<uint8_t>(fields[3]);
+    const uint64_t cells = uint64_t(record.rows) * record.columns;
+    if (cells == 0) return false;
+
+    // Lengths come from the file: bound them before allocating
+    if (!read_varint(value) || value > cells * GameRecord::MAX_MOVES_PER_CELL) return false;
+    record.moves.resize(value);
+    record.placed_cells.clear();
+    for (auto& m : record.moves) {
+        uint64_t cell;
+        if (!read_varint(cell) || cell / 2 >= cells) return false;
+        m = RecordedMove();
+        m.x = static_cast<uint8_t>(cell / 2 / record.columns);
+        m.y = static_cast<uint8_t>(cell / 2 % record.columns);
+        if (record.move_type != RecordedMoveType::PLAIN) {
+            int payload = in.get();
+            if (payload == EOF) return false;
+            if (record.move_type == RecordedMoveType::SLIDE) {
+                m.dx = static_cast<int8_t>(payload / 3 - 1);
+                m.dy = static_cast<int8_t>(payload % 3 - 1);
+            } else {
+                m.value = static_cast<char>(payload);
+            }
+        }
+        if (!(cell & 1)) continue;
+        if (!read_varint(value) || value > cells || value > 255) return false;
+        m.placed = static_cast<uint8_t>(value);
+        for (int k = 0; k < m.placed; k++) {
+            uint64_t placed;
+            if (!read_varint(placed) || placed >= cells) return false;
+            record.placed_cells.push_back(static_cast<uint8_t>(placed));
+        }
+    }
+    return true;
+}
+
+//--------------------------------------- Recorder
+
+void GameRecorder::start(const Board<char>& board, Player<char>* const players[2]) {
+    current.players[0] = players[0]->get_name();
+    current.players[1] = players[1]->get_name();
+    current.rows = static_cast<uint8_t>(board.get_rows());
+    current.columns = static_cast<uint8_t>(board.get_columns());
+    current.move_type = RecordedMoveType::PLAIN;
+    current.result = GameRecord::UNFINISHED;
+    current.moves.clear();
+    current.placed_cells.clear();
+    this->board = &board;
+}
+
+void GameRecorder::record(const Move<char>& move) {
+    RecordedMove m = recorded_move(move, current.move_type);
+    if (auto obstacles = dynamic_cast<const Obstacles_XO_Board*>(board)) {
+        size_t seen = current.placed_cells.size();
+        for (size_t k = seen; k < obstacles->get_obstacles().size(); k++) {
+            auto cell = obstacles->get_obstacles()[k];
+            current.placed_cells.push_back(static_cast<uint8_t>(cell.first * current.columns + cell.second));
+        }
+        m.placed = static_cast<uint8_t>(current.placed_cells.size() - seen);
+    }
+    current.moves.push_back(m);
+}
+
+void GameRecorder::finish(int winner, bool finished) {
+    if (!finished) current.result = GameRecord::UNFINISHED;
+    else if (winner < 0) current.result = GameRecord::DRAW;
+    else current.result = winner == 0 ? GameRecord::X_WINS : GameRecord::O_WINS;
+    writer.write(current);
+}
@@ -28,17 +28,21 @@ bool Infinity_X_O_Board::update_board(Move<char>* move) {
         if (mark == 0) { // Undo move
             n_moves--;
             board[x][y] = blank_symbol;
+            bits.clear(x, y);
         }
         else {         // Apply move
             n_moves++;
             board[x][y] = toupper(mark);
+            int side = BitBoard::xo_side(mark);
+            if (side >= 0) bits.set(x, y, side);
         }
         counter++;
-        last_moves.push({x,y});
+        last_moves.push_back({x,y});
         if (counter==3) {
             auto [xl,yl] = last_moves.front();
-            last_moves.pop();
+            last_moves.pop_front();
             board[xl][yl] = blank_symbol;
+            bits.clear(xl, yl);
             counter = 0;
         }
         return true;
@@ -46,26 +50,8 @@ bool Infinity_X_O_Board::update_board(Move<char>* move) {
     return false;
 }
 
-bool Infinity_X_O_Board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
-
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-        };
-
-    // Check rows and columns
-    for (int i = 0; i < rows; ++i) {
-        if ((all_equal(board[i][0], board[i][1], board[i][2]) && board[i][0] == sym) ||
-            (all_equal(board[0][i], board[1][i], board[2][i]) && board[0][i] == sym))
-            return true;
-    }
-
-    // Check diagonals
-    if ((all_equal(board[0][0], board[1][1], board[2][2]) && board[1][1] == sym) ||
-        (all_equal(board[0][2], board[1][1], board[2][0]) && board[1][1] == sym))
-        return true;
-
-    return false;
+bool Infinity_X_O_Board::is_win(char symbol) {
+    return bits.has_line(BitBoard::xo_side(symbol), XO_3X3_LINES, 8);
 }
 
 bool Infinity_X_O_Board::is_draw(Player<char>* player) {
@@ -76,6 +62,44 @@ bool Infinity_X_O_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+// Marks still to be removed are kept as x * 3 + y, oldest first
+struct InfinityState {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("INFX");
+    static constexpr int MAX_MARKS = 200;
+    char cells[3][3];
+    int n_moves;
+    int counter;
+    BitBoard bits;
+    uint8_t n_marks;
+    uint8_t marks[MAX_MARKS];
+};
+
+bool Infinity_X_O_Board::snapshot(BoardSnapshot& s) const {
+    InfinityState st;
+    if (last_moves.size() > InfinityState::MAX_MARKS) return false;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    st.counter = counter;
+    st.bits = bits;
+    st.n_marks = static_cast<uint8_t>(last_moves.size());
+    for (size_t i = 0; i < last_moves.size(); i++)
+        st.marks[i] = static_cast<uint8_t>(last_moves[i].first * 3 + last_moves[i].second);
+    s.store(st);
+    return true;
+}
+
+bool Infinity_X_O_Board::restore(const BoardSnapshot& s) {
+    InfinityState st;
+    if (!s.load(st)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    counter = st.counter;
+    bits = st.bits;
+    last_moves.clear();
+    for (int i = 0; i < st.n_marks; i++) last_moves.emplace_back(st.marks[i] / 3, st.marks[i] % 3);
+    return true;
+}
+
 //--------------------------------------- XO_UI Implementation
 
 Infinit_XO_UI::Infinit_XO_UI() : UI<char>("Weclome to FCAI X-O Game", 3) {}
@@ -7,7 +7,6 @@ using namespace std ;
 //-------------------------------------------------Board------------------------------------------------------------------
 
 MEMORY_TIC_TAC_TOE_Board::MEMORY_TIC_TAC_TOE_Board () : Board(3,3) {
-    hidden_board = vector<vector<char>>(3, vector<char>(3, blank_symbol));
     for (auto& row : board)
         for (auto& cell : row)
             cell = blank_symbol;
@@ -21,41 +20,19 @@ bool MEMORY_TIC_TAC_TOE_Board::update_board(Move<char> *move) {
     if (x < 0 || x >= rows || y < 0 || y >= columns)
         return false;
 
-    if (hidden_board[x][y] != blank_symbol)
+    int side = BitBoard::xo_side(sym);
+    if (side < 0 || hidden_board.side_at(x, y) != -1)
         return false;
 
-    hidden_board[x][y] = sym;
-
     // visible board stays always blank
-    hidden_board[x][y] = sym;
+    hidden_board.set(x, y, side);
 
     n_moves++;
     return true;
 }
 
-bool MEMORY_TIC_TAC_TOE_Board::is_win(Player<char>* p) {
-
-    char sym = p->get_symbol();
-
-    auto eq = [&](char a, char b, char c){
-        return a == sym && b == sym && c == sym;
-    };
-
-    // rows
-    for (int i = 0; i < rows; ++i)
-        if (eq(hidden_board[i][0], hidden_board[i][1], hidden_board[i][2]))
-            return true;
-
-    // columns
-    for (int j = 0; j < columns; ++j)
-        if (eq(hidden_board[0][j], hidden_board[1][j], hidden_board[2][j]))
-            return true;
-
-    // diagonals
-    if (eq(hidden_board[0][0], hidden_board[1][1], hidden_board[2][2])) return true;
-    if (eq(hidden_board[0][2], hidden_board[1][1], hidden_board[2][0])) return true;
-
-    return false;
+bool MEMORY_TIC_TAC_TOE_Board::is_win(char symbol) {
+    return hidden_board.has_line(BitBoard::xo_side(symbol), XO_3X3_LINES, 8);
 }
 bool MEMORY_TIC_TAC_TOE_Board::is_draw(Player<char> *player) {
     return (n_moves == 9 && !is_win(player));
@@ -65,6 +42,32 @@ bool MEMORY_TIC_TAC_TOE_Board::game_is_over(Player<char> *player) {
     return is_win(player) || is_draw(player) ;
 }
 
+// Everything a position needs, copied as is (the marks are only in hidden_board)
+struct MemoryState {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("MEMO");
+    char cells[3][3];
+    int n_moves;
+    BitBoard hidden_board;
+};
+
+bool MEMORY_TIC_TAC_TOE_Board::snapshot(BoardSnapshot& s) const {
+    MemoryState st;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    st.hidden_board = hidden_board;
+    s.store(st);
+    return true;
+}
+
+bool MEMORY_TIC_TAC_TOE_Board::restore(const BoardSnapshot& s) {
+    MemoryState st;
+    if (!s.load(st)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    hidden_board = st.hidden_board;
+    return true;
+}
+
 
 //--------------------------------------UI------------------------------------------------------------------------------
 
@@ -5,6 +5,7 @@
 #include <bits/stdc++.h>
 #include "../include/Misere_Tic_Tac_Toe.h"
 #include "include/Smart_Player.h"
+#include "include/Tablebase.h"
 
 using namespace std;
 
@@ -30,35 +31,28 @@ bool Misere_Tic_Tac_Toe_board::update_board(Move<char>* move) {
         if (mark == 0) { // Undo move
             n_moves--;
             board[x][y] = blank_symbol;
+            bits.clear(x, y);
         }
         else {         // Apply move
             n_moves++;
             board[x][y] = toupper(mark);
+            int side = BitBoard::xo_side(mark);
+            if (side >= 0) bits.set(x, y, side);
         }
         return true;
         }
     return false;
 }
 bool Misere_Tic_Tac_Toe_board::is_lose(Player<char>* player) {
-    const char sym = player->get_symbol();
-
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-    };
-
-    // Check rows and columns
-    for (int i = 0; i < rows; ++i) {
-        if ((all_equal(board[i][0], board[i][1], board[i][2]) && board[i][0] == sym) ||
-            (all_equal(board[0][i], board[1][i], board[2][i]) && board[0][i] == sym))
-            return true;
-    }
-
-    // Check diagonals
-    if ((all_equal(board[0][0], board[1][1], board[2][2]) && board[1][1] == sym) ||
-        (all_equal(board[0][2], board[1][1], board[2][0]) && board[1][1] == sym))
-        return true;
+    // A mask compare per line against the mirrored X/O bitboard
+    return bits.has_line(BitBoard::xo_side(player->get_symbol()), XO_3X3_LINES, 8);
+}
 
-    return false;
+char Misere_Tic_Tac_Toe_board::winner() {
+    // Whoever completed a line lost
+    if (bits.has_line(0, XO_3X3_LINES, 8)) return 'O';
+    if (bits.has_line(1, XO_3X3_LINES, 8)) return 'X';
+    return 0;
 }
 
 bool Misere_Tic_Tac_Toe_board::is_draw(Player<char>* player) {
@@ -69,6 +63,32 @@ bool Misere_Tic_Tac_Toe_board::game_is_over(Player<char>* player) {
     return is_lose(player) || is_draw(player);
 }
 
+// Everything a position needs, copied as is
+struct MisereState {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("MISR");
+    char cells[3][3];
+    int n_moves;
+    BitBoard bits;
+};
+
+bool Misere_Tic_Tac_Toe_board::snapshot(BoardSnapshot& s) const {
+    MisereState st;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    st.bits = bits;
+    s.store(st);
+    return true;
+}
+
+bool Misere_Tic_Tac_Toe_board::restore(const BoardSnapshot& s) {
+    MisereState st;
+    if (!s.load(st)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    bits = st.bits;
+    return true;
+}
+
 char MisereSmartPlayer::get_opponent_symbol() const {
     return (this->symbol == 'X') ? 'O' : 'X';
 }
@@ -86,6 +106,7 @@ bool MisereSmartPlayer::check_3_in_row(const vector<vector<char>>& b, char symbo
 int MisereSmartPlayer::minimax_misere(vector<vector<char>>& b, bool isMaximizing, int depth) {
     char ai = this->symbol;
     char opp = get_opponent_symbol();
+    thread_search_counters().nodes++;
 
     if (check_3_in_row(b, ai)) return -10 + depth;
 
@@ -127,17 +148,24 @@ int MisereSmartPlayer::minimax_misere(vector<vector<char>>& b, bool isMaximizing
 pair<int, int> MisereSmartPlayer::calculateMove() {
     Board<char>* board_ptr = this->get_board_ptr();
     auto tempBoard = board_ptr->get_board_matrix();
+    auto begin = chrono::steady_clock::now();
+    SearchStats move_stats;
 
     int bestVal = -1000;
     int bestX = -1, bestY = -1;
 
+    // Every move is searched to the end of the game: one ply per empty cell
+    for (auto& row : tempBoard)
+        for (char cell : row)
+            if (cell == '.') move_stats.depth++;
+
     for (int i = 0; i < 3; i++) {
         for (int j = 0; j < 3; j++) {
             if (tempBoard[i][j] == '.') {
 
                 tempBoard[i][j] = symbol;
 
-                int moveVal = minimax_misere(tempBoard, false, 0);
+                int moveVal = count_search(move_stats.counters, [&] { return minimax_misere(tempBoard, false, 0); });
 
                 tempBoard[i][j] = '.';
 
@@ -149,6 +177,9 @@ pair<int, int> MisereSmartPlayer::calculateMove() {
             }
         }
     }
+
+    move_stats.elapsed_ns = elapsed_ns(begin);
+    stats.report(move_stats, get_name());
     return {bestX, bestY};
 }
 
@@ -161,8 +192,12 @@ Player<char>* Misere_Tic_Tac_Toe_UI::create_player(string& name, char symbol, Pl
     cout << "Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
          << " player: " << name << " (" << symbol << ")\n";
 
-    if (type == PlayerType::COMPUTER)
-        return new smartPlayer<char>(name, symbol, type);   // create smartPlayer
+    if (type == PlayerType::COMPUTER) {
+        // Perfect play from the solved table when bgf_solve has written it, searching otherwise
+        if (auto table = Tablebase::find("misere"))
+            return new TablebasePlayer(name, symbol, type, find_tablebase_rules("misere"), table);
+        return new MisereSmartPlayer(name, symbol, type);
+    }
 
     return new Player<char>(name, symbol, type);            // human is regular player
 }
@@ -175,6 +210,11 @@ Move<char>* Misere_Tic_Tac_Toe_UI::get_move(Player<char>* player) {
         cout << "\nPlease enter your move x and y (0 to 2): ";
         cin >> x >> y;
     }
+    else if (auto table_player = dynamic_cast<TablebasePlayer*>(player)) {
+        auto move = table_player->table_move();
+        x = move.x;
+        y = move.y;
+    }
     else if (player->get_type() == PlayerType::COMPUTER) {
         auto smart_player = dynamic_cast<smartPlayer<char>*>(player);
         auto move = smart_player->calculateMove();
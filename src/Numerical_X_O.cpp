@@ -3,19 +3,17 @@
 #include <map>
 #include <cctype>  // for toupper()
 #include "../include/Numerical_X_O.h"
+#include "../include/Tablebase.h"
+#include "../include/BitBoard.h"
+#include "../include/Smart_Player.h"
 #include <bits/stdc++.h>
 using namespace std;
 
-map<char,int> X,O;
-
 Numerical_X_O_Board::Numerical_X_O_Board() : Board(3, 3), counter(0) {
     // Initialize all cells with blank_symbol
     for (auto& row : board)
         for (auto& cell : row)
             cell = blank_symbol;
-
-    for (int i = 1; i<10;i+=2) X[(i+'0')] = 1;
-    for (int i = 2;i<10;i+=2) O[(i+'0')] = 1;
 }
 
 
@@ -34,41 +32,37 @@ bool Numerical_X_O_Board::update_board(Move<char>* move) {
 
     if (!(x < 0 || x >= rows || y < 0 || y >= columns) && (board[x][y] == blank_symbol) ) {
 
-        if(mark == 'X' && X[val] == 1) {
-            X[val] = 2;
-        }
-        else if(mark == 'O' && O[val] == 1) {
-            O[val] = 2;
-        }
-        else return false;
+        // The number must be one the player has left
+        int side = BitBoard::xo_side(mark);
+        int digit = val - '0';
+        if (side < 0 || digit < 1 || digit > 9 || !(digits[side] >> (digit - 1) & 1)) return false;
+        digits[side] &= ~(1 << (digit - 1));
         n_moves++;
         board[x][y] = val;
+        last_symbol = mark;
+
+        // Lines through (x, y): its row, its column and the diagonals it lies on
+        int through[4], n = 0;
+        through[n++] = x;
+        through[n++] = 3 + y;
+        if (x == y) through[n++] = 6;
+        if (x + y == 2) through[n++] = 7;
+        for (int i = 0; i < n; i++) {
+            int& sum = line_sum[through[i]];
+            if (sum == 15) lines_at_15--;
+            sum += val - '0';
+            if (sum == 15) lines_at_15++;
+        }
+
         counter++;
         return true;
     }
     return false;
 }
 
-bool Numerical_X_O_Board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
-
-    auto all_equal = [&](char a, char b, char c) {
-        return (a-'0')+(b-'0')+(c-'0') == 15;
-        };
-
-    // Check rows and columns
-    for (int i = 0; i < rows; ++i) {
-        if ((all_equal(board[i][0], board[i][1], board[i][2])) ||
-            (all_equal(board[0][i], board[1][i], board[2][i])))
-            return true;
-    }
-
-    // Check diagonals
-    if ((all_equal(board[0][0], board[1][1], board[2][2])) ||
-        (all_equal(board[0][2], board[1][1], board[2][0])))
-        return true;
-
-    return false;
+bool Numerical_X_O_Board::is_win(char symbol) {
+    // A sum of 15 ends the game, so it belongs to whoever moved last
+    return lines_at_15 > 0 && symbol == last_symbol;
 }
 
 bool Numerical_X_O_Board::is_draw(Player<char>* player) {
@@ -79,6 +73,217 @@ bool Numerical_X_O_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+uint16_t Numerical_X_O_Board::available_digits(char symbol) const {
+    int side = BitBoard::xo_side(symbol);
+    return side < 0 ? 0 : digits[side];
+}
+
+// Everything a position needs, copied as is
+struct NumericalState {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("NUMX");
+    char cells[3][3];
+    int n_moves;
+    int counter;
+    int line_sum[8];
+    int lines_at_15;
+    char last_symbol;
+    uint16_t digits[2];
+};
+
+bool Numerical_X_O_Board::snapshot(BoardSnapshot& s) const {
+    NumericalState st;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    st.counter = counter;
+    memcpy(st.line_sum, line_sum, sizeof(line_sum));
+    st.lines_at_15 = lines_at_15;
+    st.last_symbol = last_symbol;
+    st.digits[0] = digits[0];
+    st.digits[1] = digits[1];
+    s.store(st);
+    return true;
+}
+
+bool Numerical_X_O_Board::restore(const BoardSnapshot& s) {
+    NumericalState st;
+    if (!s.load(st)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    counter = st.counter;
+    memcpy(line_sum, st.line_sum, sizeof(line_sum));
+    lines_at_15 = st.lines_at_15;
+    last_symbol = st.last_symbol;
+    digits[0] = st.digits[0];
+    digits[1] = st.digits[1];
+    return true;
+}
+
+//--------------------------------------- AI player
+
+// Cells (x * 3 + y) of each line, in the order of line_sum: rows, columns, then the diagonals
+static const int NUMERICAL_LINES[8][3] = {
+    {0, 1, 2}, {3, 4, 5}, {6, 7, 8},
+    {0, 3, 6}, {1, 4, 7}, {2, 5, 8},
+    {0, 4, 8}, {2, 4, 6}
+};
+
+// Negamax over (cell, number) moves. The numbers a side may play come from the board's
+// masks, so a position is nine cells, eight line sums and two 9-bit masks.
+class NumericalAIPlayer : public smartPlayer<char> {
+    struct Position {
+        int cell[9];         // number in each cell, 0 if empty
+        int line_sum[8];
+        uint16_t digits[2];  // numbers X and O have left, bit d - 1 for digit d
+        int empties;
+    };
+
+    static constexpr int INF = 1000000;
+
+    // Lines through each cell (2 to 4 of them)
+    int through[9][4];
+    int n_through[9] = {0};
+
+    // Whether writing d in cell c makes one of its lines sum to 15
+    bool wins(const Position& p, int c, int d) const {
+        for (int k = 0; k < n_through[c]; k++)
+            if (p.line_sum[through[c][k]] + d == 15) return true;
+        return false;
+    }
+
+    void play(Position& p, int c, int d, int side) const {
+        p.cell[c] = d;
+        for (int k = 0; k < n_through[c]; k++) p.line_sum[through[c][k]] += d;
+        p.digits[side] &= ~(1 << (d - 1));
+        p.empties--;
+    }
+
+    void undo(Position& p, int c, int d, int side) const {
+        p.cell[c] = 0;
+        for (int k = 0; k < n_through[c]; k++) p.line_sum[through[c][k]] -= d;
+        p.digits[side] |= 1 << (d - 1);
+        p.empties++;
+    }
+
+    // Score for side, to move: 1000 + plies left for a win (sooner is better), 0 for a draw
+    int negamax(Position& p, int side, int depth, int alpha, int beta) {
+        if (time_up()) return 0; // result is thrown away with the aborted iteration
+        SearchCounters& counters = thread_search_counters();
+        counters.nodes++;
+
+        // A sum of 15 ends the game at once, so any winning move is the best one
+        for (int c = 0; c < 9; c++) {
+            if (p.cell[c]) continue;
+            for (int d = 1; d <= 9; d++)
+                if ((p.digits[side] >> (d - 1) & 1) && wins(p, c, d)) return 1000 + depth;
+        }
+        if (p.empties == 0) return 0;
+        if (depth == 0) {
+            counters.leaves++;
+            return 0;
+        }
+
+        int best = -INF;
+        int tried = 0; // index of the move being searched, for the cutoff statistics
+        for (int c = 0; c < 9; c++) {
+            if (p.cell[c]) continue;
+            for (int d = 1; d <= 9; d++) {
+                if (!(p.digits[side] >> (d - 1) & 1)) continue;
+                play(p, c, d, side);
+                int val = -negamax(p, 1 - side, depth - 1, -beta, -alpha);
+                undo(p, c, d, side);
+                best = max(best, val);
+                alpha = max(alpha, best);
+                if (alpha >= beta) {
+                    counters.cutoff(tried);
+                    return best;
+                }
+                tried++;
+            }
+        }
+        return best;
+    }
+
+public:
+    NumericalAIPlayer(string n, char s, PlayerType t) : smartPlayer<char>(n, s, t) {
+        for (int k = 0; k < 8; k++)
+            for (int c : NUMERICAL_LINES[k]) through[c][n_through[c]++] = k;
+    }
+
+    // The pondering thread calls the overrides below: stop it while they still exist
+    ~NumericalAIPlayer() override { stop_pondering(); }
+
+    // Iterative deepening within the time budget, previous best (cell, number) searched first
+    pair<pair<int,int>,char> calculateMove2() {
+        auto board_ptr = dynamic_cast<Numerical_X_O_Board*>(this->get_board_ptr());
+        if (!board_ptr) throw runtime_error("Board not assigned to player!");
+
+        auto begin = chrono::steady_clock::now();
+        SearchStats move_stats;
+        auto b = board_ptr->get_board_matrix();
+        Position p{};
+        for (int c = 0; c < 9; c++) {
+            p.cell[c] = b[c / 3][c % 3] - '0';
+            if (!p.cell[c]) p.empties++;
+        }
+        for (int k = 0; k < 8; k++)
+            for (int c : NUMERICAL_LINES[k]) p.line_sum[k] += p.cell[c];
+        p.digits[0] = board_ptr->available_digits('X');
+        p.digits[1] = board_ptr->available_digits('O');
+        int side = BitBoard::xo_side(this->get_symbol());
+
+        vector<pair<int,int>> moves; // (cell, number)
+        for (int c = 0; c < 9; c++) {
+            if (p.cell[c]) continue;
+            for (int d = 1; d <= 9; d++) {
+                if (!(p.digits[side] >> (d - 1) & 1)) continue;
+                if (wins(p, c, d)) {
+                    move_stats.depth = 1;
+                    move_stats.elapsed_ns = elapsed_ns(begin);
+                    stats.report(move_stats, get_name());
+                    return {{c / 3, c % 3}, static_cast<char>('0' + d)};
+                }
+                moves.push_back({c, d});
+            }
+        }
+        if (moves.empty()) return {{-1, -1}, '0'};
+
+        start_search_clock();
+        pair<int,int> best = moves[0];
+        vector<int> scores(moves.size());
+        for (int depth = 0; depth < max_search_depth; depth++) {
+            int alpha = -INF;
+            int iter_best = -1;
+            for (size_t k = 0; k < moves.size() && !search_aborted; k++) {
+                auto [c, d] = moves[k];
+                play(p, c, d, side);
+                scores[k] = -count_search(move_stats.counters, [&] { return negamax(p, 1 - side, depth, -INF, -alpha); });
+                undo(p, c, d, side);
+                if (!search_aborted && scores[k] > alpha) {
+                    alpha = scores[k];
+                    iter_best = (int)k;
+                }
+            }
+            if (search_aborted) break;
+            if (iter_best >= 0) best = moves[iter_best];
+            move_stats.depth = depth + 1;
+
+            // Stop once the result is proven or every remaining ply was searched
+            if (alpha >= 1000 || alpha <= -1000 || depth + 2 >= p.empties) break;
+
+            vector<size_t> order(moves.size());
+            for (size_t k = 0; k < order.size(); k++) order[k] = k;
+            stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) { return scores[x] > scores[y]; });
+            vector<pair<int,int>> sorted;
+            for (size_t k : order) sorted.push_back(moves[k]);
+            moves = sorted;
+        }
+
+        move_stats.elapsed_ns = elapsed_ns(begin);
+        stats.report(move_stats, get_name());
+        return {{best.first / 3, best.first % 3}, static_cast<char>('0' + best.second)};
+    }
+};
+
 //--------------------------------------- XO_UI Implementation
 
 Numerical_XO_UI::Numerical_XO_UI() : UI<char>("Weclome to FCAI X-O Game", 3) {}
@@ -88,6 +293,13 @@ Player<char>* Numerical_XO_UI::create_player(string& name, char symbol, PlayerTy
     cout << "Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
         << " player: " << name << " (" << symbol << ")\n";
 
+    // Perfect play from the solved table when bgf_solve has written it, a search otherwise
+    if (type == PlayerType::COMPUTER) {
+        if (auto table = Tablebase::find("numerical"))
+            return new TablebasePlayer(name, symbol, type, find_tablebase_rules("numerical"), table);
+        return new NumericalAIPlayer(name, symbol, type);
+    }
+
     return new Player<char>(name, symbol, type);
 }
 
@@ -100,24 +312,30 @@ Move<char>* Numerical_XO_UI::get_move(Player<char>* player) {
         cout << "\nPlease enter your move x and y (0 to 2) and value: ";
         cin >> x >> y >> val;
     }
+    else if (auto table_player = dynamic_cast<TablebasePlayer*>(player)) {
+        auto move = table_player->table_move();
+        x = move.x;
+        y = move.y;
+        val = move.value;
+    }
+    else if (auto ai_player = dynamic_cast<NumericalAIPlayer*>(player)) {
+        auto move = ai_player->calculateMove2();
+        x = move.first.first;
+        y = move.first.second;
+        val = move.second;
+    }
     else if (player->get_type() == PlayerType::COMPUTER) {
+        // Random cell and one of the player's numbers left
         x = rand() % player->get_board_ptr()->get_rows();
         y = rand() % player->get_board_ptr()->get_columns();
-        random_device rd;
-        mt19937 gen(rd());
-
-        int L = 1, R = 9;
-        if(player->get_symbol() == 'X') {
-            uniform_int_distribution<int> odd_dist(L/2, (R-1)/2);
-            int num = odd_dist(gen) * 2 + 1;
-            val = (num+'0');
+        val = player->get_symbol() == 'X' ? '1' : '2';
+        if (auto board_ptr = dynamic_cast<Numerical_X_O_Board*>(player->get_board_ptr())) {
+            uint16_t left = board_ptr->available_digits(player->get_symbol());
+            vector<char> numbers;
+            for (int d = 1; d <= 9; d++)
+                if (left >> (d - 1) & 1) numbers.push_back(static_cast<char>('0' + d));
+            if (!numbers.empty()) val = numbers[rand() % numbers.size()];
         }
-        else {
-            uniform_int_distribution<int> even_dist((L+1)/2, R/2);
-            int num = even_dist(gen) * 2;
-            val = (num+'0');
-        }
-
     }
 
     /**
@@ -5,13 +5,15 @@ using namespace std;
 
 //--------------------------------------- Board Implementation
 
-Obstacles_XO_Board::Obstacles_XO_Board() : Board<char>(6, 6) {
+Obstacles_XO_Board::Obstacles_XO_Board() : Board<char>(6, 6), lines(6, 6) {
 
     for (int i = 0; i < rows; i++) {
         for (int j = 0; j < columns; j++) {
             board[i][j] = '.';
         }
     }
+    // Obstacles belong to no side, so they simply never complete a line
+    lines.add_all_runs(4);
 }
 
 bool Obstacles_XO_Board::update_board(Move<char>* move) {
@@ -32,6 +34,8 @@ bool Obstacles_XO_Board::update_board(Move<char>* move) {
             // Apply move
             n_moves++;
             board[x][y] = toupper(mark);
+            int side = BitBoard::xo_side(board[x][y]);
+            if (side >= 0) lines.place(x, y, side);
         }
 
         
@@ -41,11 +45,19 @@ bool Obstacles_XO_Board::update_board(Move<char>* move) {
             // We loop until we place 2 obstacles or verify board is full
             int safety_counter = 0; 
             while (obstacles_added < 2 && n_moves < 36 && safety_counter < 1000) {
-                int r = rand() % 6;
-                int c = rand() % 6;
+                int r, c;
+                if (!queued.empty()) {
+                    r = queued.front().first;
+                    c = queued.front().second;
+                    queued.pop_front();
+                } else {
+                    r = rand() % 6;
+                    c = rand() % 6;
+                }
                 
-                if (board[r][c] == '.') {
+                if (r >= 0 && r < rows && c >= 0 && c < columns && board[r][c] == '.') {
                     board[r][c] = obstacle_symbol;
+                    obstacles.emplace_back(r, c);
                     n_moves++; // Count obstacle as a filled spot
                     obstacles_added++;
                 }
@@ -59,52 +71,9 @@ bool Obstacles_XO_Board::update_board(Move<char>* move) {
     return false;
 }
 
-bool Obstacles_XO_Board::is_win(Player<char>* player) {
-    char sym = player->get_symbol();
-
-    // Check for 4 consecutive symbols in any direction
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < columns; j++) {
-            
-            // Only verify if the current cell belongs to the player
-            if (board[i][j] != sym) continue;
-
-            // 1. Check Horizontal (Right)
-            // Ensure we have room for 3 more cells to the right
-            if (j + 3 < columns && 
-                board[i][j+1] == sym && 
-                board[i][j+2] == sym && 
-                board[i][j+3] == sym) {
-                return true;
-            }
-
-            // 2. Check Vertical (Down)
-            // Ensure we have room for 3 more cells downwards
-            if (i + 3 < rows && 
-                board[i+1][j] == sym && 
-                board[i+2][j] == sym && 
-                board[i+3][j] == sym) {
-                return true;
-            }
-
-            // 3. Check Diagonal (Down-Right)
-            if (i + 3 < rows && j + 3 < columns && 
-                board[i+1][j+1] == sym && 
-                board[i+2][j+2] == sym && 
-                board[i+3][j+3] == sym) {
-                return true;
-            }
-
-            // 4. Check Anti-Diagonal (Down-Left)
-            if (i + 3 < rows && j - 3 >= 0 && 
-                board[i+1][j-1] == sym && 
-                board[i+2][j-2] == sym && 
-                board[i+3][j-3] == sym) {
-                return true;
-            }
-        }
-    }
-    return false;
+bool Obstacles_XO_Board::is_win(char symbol) {
+    // 4 consecutive symbols in any direction
+    return lines.has_line(BitBoard::xo_side(symbol));
 }
 
 bool Obstacles_XO_Board::is_draw(Player<char>* player) {
@@ -116,6 +85,37 @@ bool Obstacles_XO_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+// Obstacles are kept as x * 6 + y in placement order; the line counts are rebuilt from the cells
+struct ObstaclesState {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("OBST");
+    char cells[6][6];
+    int n_moves;
+    uint8_t n_obstacles;
+    uint8_t obstacles[36];
+};
+
+bool Obstacles_XO_Board::snapshot(BoardSnapshot& s) const {
+    ObstaclesState st;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    st.n_obstacles = static_cast<uint8_t>(obstacles.size());
+    for (size_t i = 0; i < obstacles.size(); i++)
+        st.obstacles[i] = static_cast<uint8_t>(obstacles[i].first * columns + obstacles[i].second);
+    s.store(st);
+    return true;
+}
+
+bool Obstacles_XO_Board::restore(const BoardSnapshot& s) {
+    ObstaclesState st;
+    if (!s.load(st)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    obstacles.clear();
+    for (int i = 0; i < st.n_obstacles; i++) obstacles.emplace_back(st.obstacles[i] / columns, st.obstacles[i] % columns);
+    lines.rebuild(board, BitBoard::xo_side);
+    return true;
+}
+
 
 //--------------------------------------- UI Implementation
 
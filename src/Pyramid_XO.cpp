@@ -5,11 +5,23 @@
 #include "../include/Pyramid_XO.h"
 #include "include/BoardGame_Classes.h"
 #include "include/Smart_Player.h"
+#include "include/Tablebase.h"
 
 using namespace std;
 
 //=======Pyramid XO Board Implementation==================
 
+/// Line masks of the pyramid on the 3x5 grid (bit index = x * 5 + y).
+static constexpr uint32_t PYRAMID_LINES[7] = {
+    cell_bit(5, 0, 2) | cell_bit(5, 1, 2) | cell_bit(5, 2, 2), // middle column
+    cell_bit(5, 1, 1) | cell_bit(5, 1, 2) | cell_bit(5, 1, 3), // 2nd row
+    cell_bit(5, 2, 0) | cell_bit(5, 2, 1) | cell_bit(5, 2, 2), // 3rd row
+    cell_bit(5, 2, 1) | cell_bit(5, 2, 2) | cell_bit(5, 2, 3),
+    cell_bit(5, 2, 2) | cell_bit(5, 2, 3) | cell_bit(5, 2, 4),
+    cell_bit(5, 0, 2) | cell_bit(5, 1, 1) | cell_bit(5, 2, 0), // diagonals
+    cell_bit(5, 0, 2) | cell_bit(5, 1, 3) | cell_bit(5, 2, 4)
+};
+
 Pyramid_XO_Board::Pyramid_XO_Board() : Board<char>(3,5) {
     int distant[3] = {0,1,2}; // range for each row to build pyramid shape
     for (int i = 0; i<rows; i++) {
@@ -32,37 +44,15 @@ bool Pyramid_XO_Board::update_board(Move<char> *move) {
 
         n_moves++;
         board[x][y] = mark;
+        int side = BitBoard::xo_side(mark);
+        if (side >= 0) bits.set(x, y, side);
         return true;
     }
     return false;
 }
 
-bool Pyramid_XO_Board::is_win(Player<char> *player) {
-    const char sym = player->get_symbol();
-
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-    };
-
-    // Check Column (3*5 pyramid has only one column possible column of size 3)
-    if (all_equal(board[0][2],board[1][2],board[2][2]) && board[0][2]==sym ) return true;
-
-    // Check 2nd row
-    if (all_equal(board[1][1],board[1][2],board[1][3]) && board[1][1]==sym ) return true;
-
-    // Check 3rd row
-    if (all_equal(board[2][0],board[2][1],board[2][2]) && board[2][2]==sym ) return true;
-    if (all_equal(board[2][1],board[2][2],board[2][3]) && board[2][2]==sym ) return true;
-    if (all_equal(board[2][2],board[2][3],board[2][4]) && board[2][2]==sym ) return true;
-
-
-
-    // Check diagonals of pyramid (has only two diagonals)
-    if ((all_equal(board[0][2], board[1][1], board[2][0]) && board[0][2] == sym) ||
-        (all_equal(board[0][2], board[1][3], board[2][4]) && board[0][2] == sym))
-        return true;
-
-    return false;
+bool Pyramid_XO_Board::is_win(char symbol) {
+    return bits.has_line(BitBoard::xo_side(symbol), PYRAMID_LINES, 7);
 }
 
 bool Pyramid_XO_Board::is_draw(Player<char>* player) {
@@ -73,6 +63,32 @@ bool Pyramid_XO_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+// Everything a position needs, copied as is
+struct PyramidState {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("PYRM");
+    char cells[3][5];
+    int n_moves;
+    BitBoard bits;
+};
+
+bool Pyramid_XO_Board::snapshot(BoardSnapshot& s) const {
+    PyramidState st;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    st.bits = bits;
+    s.store(st);
+    return true;
+}
+
+bool Pyramid_XO_Board::restore(const BoardSnapshot& s) {
+    PyramidState st;
+    if (!s.load(st)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    bits = st.bits;
+    return true;
+}
+
 //=========Pyramid UI Implementation =========
 
 
@@ -85,8 +101,12 @@ Player<char>* Pyramid_XO_UI::create_player(string& name, char symbol, PlayerType
     cout << "Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
          << " player: " << name << " (" << symbol << ")\n";
 
-    if (type == PlayerType::COMPUTER)
+    if (type == PlayerType::COMPUTER) {
+        // Perfect play from the solved table when bgf_solve has written it, searching otherwise
+        if (auto table = Tablebase::find("pyramid"))
+            return new TablebasePlayer(name, symbol, type, find_tablebase_rules("pyramid"), table);
         return new smartPlayer<char>(name, symbol, type);   // create smartPlayer
+    }
 
     return new Player<char>(name, symbol, type);            // human is regular player
 }
@@ -99,6 +119,11 @@ Move<char>* Pyramid_XO_UI::get_move(Player<char>* player) {
         cout << "\nPlease enter your move x and y (0 to 2): ";
         cin >> x >> y;
     }
+    else if (auto table_player = dynamic_cast<TablebasePlayer*>(player)) {
+        auto move = table_player->table_move();
+        x = move.x;
+        y = move.y;
+    }
     else if (player->get_type() == PlayerType::COMPUTER) {
         auto smart_player = dynamic_cast<smartPlayer<char>*>(player);
         auto move = smart_player->calculateMove();
@@ -1,5 +1,6 @@
 #include "../include/SUS_Classes.h"
 #include "../include/Smart_Player.h"
+#include "../include/Tablebase.h"
 #include <bits/stdc++.h>
 
 using namespace std;
@@ -13,21 +14,21 @@ protected:
     vector<string> dictionary;
     vector<char> possibleLetters;      // only letters that appear in the dictionary
     mutable unsigned long node_counter = 0; // count nodes visited (mutable to update in const funcs)
-    const unsigned long MAX_NODES = 50000; // tune this: 200k node budget as example
 
 
 public:
-    SUS_SmartPlayer(string n, char s, PlayerType t, const string& dictFile)
+    SUS_SmartPlayer(string n, char s, PlayerType t)
             : smartPlayer<char>(n, s, t)
     {
-        loadDictionary(dictFile);
+        loadDictionary();
     }
 
+    // The pondering thread calls the overrides below: stop it while they still exist
+    ~SUS_SmartPlayer() override { stop_pondering(); }
+
 protected:
-    void loadDictionary(const string& filename) {
-        ifstream in(filename);
-        string w;
-        unordered_set<char> letters;
+    // The only word of the game is "SUS": no word list is read
+    void loadDictionary() {
         dictionary.push_back("SUS");
         // build possibleLetters vector from set (stable order not required)
         possibleLetters.push_back('S');
@@ -39,7 +40,7 @@ protected:
     }
 
 
-    virtual bool is_win(const vector<vector<char>>& b, char s, int N = 3) const override {
+    virtual bool is_win(const vector<vector<char>>& b, char /*s*/, int /*N*/ = 3) const override {
         int R = b.size();
         int C = b[0].size();
 
@@ -85,7 +86,7 @@ protected:
         return find(dictionary.begin(), dictionary.end(), cleaned) != dictionary.end();
     }
 
-    virtual int evaluate_board(const vector<vector<char>>& b, char ai, char opp, int N = 3) const override {
+    virtual int evaluate_board(const vector<vector<char>>& b, char ai, char opp, int /*N*/ = 3) const override {
         // Scoring: more letters forming a prefix of any word = higher score
         int score = 0;
 
@@ -97,7 +98,7 @@ protected:
         return score;
     }
 
-    int score_line(const vector<vector<char>>& b, const string& word, char symbol) const {
+    int score_line(const vector<vector<char>>& b, const string& word, char /*symbol*/) const {
         int R = b.size();
         int C = b[0].size();
         int score = 0;
@@ -131,7 +132,9 @@ protected:
 {
     // node accounting
     ++node_counter;
-    if (node_counter > MAX_NODES) {
+    SearchCounters& counters = thread_search_counters();
+    counters.nodes++;
+    if (time_up()) {
         // abort search early: return heuristic evaluation to let caller use partial result
         return evaluate_board(b, ai, opp, N);
     }
@@ -139,10 +142,14 @@ protected:
     if (is_win(b, ai, N)) return 1000 + depth; // prefer faster win
     if (is_win(b, opp, N)) return -1000 - depth; // prefer slower loss
     if (is_draw(b, N)) return 0;
-    if (depth == 0) return evaluate_board(b, ai, opp, N);
+    if (depth == 0) {
+        counters.leaves++;
+        return evaluate_board(b, ai, opp, N);
+    }
 
     int rows = b.size();
     int cols = b[0].size();
+    int tried = 0; // index of the move being searched, for the cutoff statistics
 
     if (maximizingPlayer) {
         int best = numeric_limits<int>::min();
@@ -157,10 +164,12 @@ protected:
                     if (best > alpha) alpha = best;
                     if (beta <= alpha) {
                         // pruning - break out early
+                        counters.cutoff(tried);
                         goto OUT_MAX_LOOP;
                     }
-                    // early node budget check
-                    if (node_counter > MAX_NODES) goto OUT_MAX_LOOP;
+                    tried++;
+                    // early time budget check
+                    if (search_aborted) goto OUT_MAX_LOOP;
                 }
             }
         }
@@ -178,9 +187,11 @@ OUT_MAX_LOOP:
                     if (val < best) best = val;
                     if (best < beta) beta = best;
                     if (beta <= alpha) {
+                        counters.cutoff(tried);
                         goto OUT_MIN_LOOP;
                     }
-                    if (node_counter > MAX_NODES) goto OUT_MIN_LOOP;
+                    tried++;
+                    if (search_aborted) goto OUT_MIN_LOOP;
                 }
             }
         }
@@ -194,57 +205,87 @@ public:
         Board<char>* board_ptr = this->get_board_ptr();
         if (!board_ptr) throw runtime_error("Board not assigned to player!");
 
+        auto begin = chrono::steady_clock::now();
+        SearchStats move_stats;
         auto tempBoard = board_ptr->get_board_matrix();
         int rows = tempBoard.size();
         int cols = tempBoard[0].size();
 
-        int bestVal = numeric_limits<int>::min();
         int bestX = -1, bestY = -1;
         char bestc = '#';
 
         char ai = this->get_symbol();
         char opp = get_opponent_symbol();
 
-        // search configuration
-        int maxDepth = 1; // can drop to 1 if slow; raise if you add pruning/time limits
-        node_counter = 0; // reset before search
-
         // If possibleLetters empty (shouldn't be), fall back
         if (possibleLetters.empty()) possibleLetters = LETTERS;
 
-        for (int i = 0; i < rows; ++i) {
-            for (int j = 0; j < cols; ++j) {
-                if (tempBoard[i][j] != '.') continue;
-                for (char c : possibleLetters) {
-                    tempBoard[i][j] = c;
-                    int moveVal = minimax(tempBoard, false, ai, opp,
-                                          numeric_limits<int>::min(),
-                                          numeric_limits<int>::max(),
-                                          maxDepth);
-                    tempBoard[i][j] = '.';
-                    if (moveVal > bestVal) {
-                        bestVal = moveVal;
-                        bestX = i;
-                        bestY = j;
-                        bestc = c;
+        int empties = 0;
+        for (auto& row : tempBoard)
+            for (char cell : row)
+                if (cell == '.') empties++;
+
+        // Iterative deepening within the time budget, previous best (cell, letter) searched first
+        start_search_clock();
+        for (int maxDepth = 0; maxDepth < max_search_depth; maxDepth++) {
+            node_counter = 0; // reset before each iteration
+            int bestVal = numeric_limits<int>::min();
+            int iterX = -1, iterY = -1;
+            char iterc = '#';
+
+            auto search_root = [&](int i, int j, char c) {
+                tempBoard[i][j] = c;
+                int moveVal = count_search(move_stats.counters, [&] {
+                    return minimax(tempBoard, false, ai, opp,
+                                   bestVal,
+                                   numeric_limits<int>::max(),
+                                   maxDepth);
+                });
+                tempBoard[i][j] = '.';
+                if (moveVal > bestVal) {
+                    bestVal = moveVal;
+                    iterX = i;
+                    iterY = j;
+                    iterc = c;
+                }
+            };
+
+            if (bestX != -1) search_root(bestX, bestY, bestc);
+            for (int i = 0; i < rows && !search_aborted; ++i) {
+                for (int j = 0; j < cols && !search_aborted; ++j) {
+                    if (tempBoard[i][j] != '.') continue;
+                    for (char c : possibleLetters) {
+                        if (i == bestX && j == bestY && c == bestc) continue;
+                        search_root(i, j, c);
+                        if (search_aborted) break;
                     }
-                    // optional: if node budget reached, break entirely
-                    if (node_counter > MAX_NODES) break;
                 }
-                if (node_counter > MAX_NODES) break;
             }
-            if (node_counter > MAX_NODES) break;
+
+            // An aborted iteration only counts if nothing has completed yet
+            if (search_aborted && bestX != -1) break;
+            bestX = iterX;
+            bestY = iterY;
+            bestc = iterc;
+            if (!search_aborted) move_stats.depth = maxDepth + 1;
+            if (search_aborted || bestVal >= 1000 || maxDepth + 1 >= empties) break;
         }
 
         // Debug: print nodes visited (remove in production)
         // cerr << "AI nodes visited: " << node_counter << ", bestVal=" << bestVal << "\n";
 
+        move_stats.elapsed_ns = elapsed_ns(begin);
+        stats.report(move_stats, get_name());
+
         return {{bestX, bestY}, bestc};
     }
 
 };
 
 
+/// Middle cell of each 3x3 line, in the same order as XO_3X3_LINES.
+static constexpr uint32_t SUS_MIDDLE[8] = {0x002, 0x010, 0x080, 0x008, 0x010, 0x020, 0x010, 0x010};
+
 bool Check_SUS(const string& W) {
     if (W == "SUS") return true;
     return false;
@@ -271,37 +312,27 @@ bool SUS_Board::update_board(Move<char>* move) {
     if (!(x < 0 || x >= rows || y < 0 || y >= columns) && board[x][y] == blank_symbol) {
         n_moves++;
         board[x][y] = toupper(val);
+        if (board[x][y] == 'S') bits.set(x, y, 0);
+        else if (board[x][y] == 'U') bits.set(x, y, 1);
+        last_symbol = toupper(mark);
         return true;
     }
     return false;
 }
 
-bool SUS_Board::is_win(Player<char>* player) {
-
-    const char sym = player->get_symbol();
+bool SUS_Board::is_win(char symbol) {
+    // Only the player who just moved can have completed the deciding line
+    if (toupper(symbol) != last_symbol) return false;
 
     int score = 0;
 
-    auto isSUS = [&](char a, char b, char c) {
-        return (a == 'S' && b == 'U' && c == 'S');
-    };
-
-    // Check rows
-    for (int i = 0; i < 3; i++) {
-        if (isSUS(board[i][0], board[i][1], board[i][2])) score++;
-    }
-
-    // Check columns
-    for (int j = 0; j < 3; j++) {
-        if (isSUS(board[0][j], board[1][j], board[2][j])) score++;
+    // A line spells S-U-S when both ends are in the 'S' mask and the middle in the 'U' mask
+    uint32_t s_mask = bits.get_mask(0), u_mask = bits.get_mask(1);
+    for (int k = 0; k < 8; k++) {
+        uint32_t ends = XO_3X3_LINES[k] & ~SUS_MIDDLE[k];
+        if ((s_mask & ends) == ends && (u_mask & SUS_MIDDLE[k])) score++;
     }
 
-    // Check main diagonal
-    if (isSUS(board[0][0], board[1][1], board[2][2])) score++;
-
-    // Check anti-diagonal
-    if (isSUS(board[0][2], board[1][1], board[2][0])) score++;
-
     if (score % 2 == 1) return true;
     return false;
 
@@ -315,6 +346,35 @@ bool SUS_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player) ;
 }
 
+// Everything a position needs, copied as is
+struct SUSState {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("SUSG");
+    char cells[3][3];
+    int n_moves;
+    BitBoard bits;
+    char last_symbol;
+};
+
+bool SUS_Board::snapshot(BoardSnapshot& s) const {
+    SUSState st;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    st.bits = bits;
+    st.last_symbol = last_symbol;
+    s.store(st);
+    return true;
+}
+
+bool SUS_Board::restore(const BoardSnapshot& s) {
+    SUSState st;
+    if (!s.load(st)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    bits = st.bits;
+    last_symbol = st.last_symbol;
+    return true;
+}
+
 
 
 // ---------------------- UI ----------------------
@@ -328,10 +388,11 @@ Player<char>* SUS_UI::create_player(string& name, char symbol, PlayerType type)
 
     if (type == PlayerType::HUMAN) {
         return new Player<char>(name, symbol, type);
+    } else if (auto table = Tablebase::find("sus")) {
+        // Perfect play from the solved table written by bgf_solve
+        return new TablebasePlayer(name, symbol, type, find_tablebase_rules("sus"), table);
     } else {
-        // Construct a wordSmartPlayer and pass the dictionary file path
-        // Make sure "dic.txt" path is correct relative to your working dir
-        return new SUS_SmartPlayer(name, symbol, type, "dic.txt");
+        return new SUS_SmartPlayer(name, symbol, type);
     }
 }
 
@@ -347,6 +408,12 @@ Move<char>* SUS_UI::get_move(Player<char>* player) {
             cin >> c;
         }
     }
+    else if (auto table_player = dynamic_cast<TablebasePlayer*>(player)) {
+        auto move = table_player->table_move();
+        x = move.x;
+        y = move.y;
+        c = move.value;
+    }
     else if (player->get_type() == PlayerType::COMPUTER) {
         auto smart_player = dynamic_cast<SUS_SmartPlayer*>(player);
         if (!smart_player) {
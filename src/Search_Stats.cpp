@@ -0,0 +1,58 @@
+//
+// Created by abdelhamid on 12/21/25.
+//
+
+#include "../include/Search_Stats.h"
+#include <cstdio>
+
+using namespace std;
+
+static void put_string(string& json, const string& s) {
+    json += '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            json += '\\';
+            json += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            json += escaped;
+        } else {
+            json += c;
+        }
+    }
+    json += '"';
+}
+
+string SearchStats::to_json() const {
+    string json = "{\"game\":";
+    put_string(json, game);
+    json += ",\"player\":";
+    put_string(json, player);
+    json += ",\"move\":" + to_string(move);
+    json += ",\"depth\":" + to_string(depth);
+    json += ",\"nodes\":" + to_string(counters.nodes);
+    json += ",\"leaves\":" + to_string(counters.leaves);
+    json += ",\"cutoffs\":[";
+    for (int i = 0; i < SearchCounters::CUTOFF_SLOTS; i++) {
+        if (i) json += ',';
+        json += to_string(counters.cutoffs[i]);
+    }
+    json += "],\"tt_probes\":" + to_string(counters.tt_probes);
+    json += ",\"tt_hits\":" + to_string(counters.tt_hits);
+    json += ",\"ns\":" + to_string(elapsed_ns);
+    json += ",\"nps\":" + to_string(static_cast<uint64_t>(nps()));
+    json += ",\"pondered\":";
+    json += pondered ? "true" : "false";
+    json += ",\"ponder_nodes\":" + to_string(ponder_nodes);
+    json += ",\"ponder_ns\":" + to_string(ponder_ns);
+    json += '}';
+    return json;
+}
+
+void SearchStatsFile::report(const SearchStats& stats) {
+    // Format outside the lock, a line is written in one piece
+    string line = stats.to_json() + "\n";
+    lock_guard<mutex> guard(lock);
+    out << line << flush;
+}
@@ -0,0 +1,320 @@
+//
+// Created by abdelhamid on 12/17/25.
+//
+
+#include "../include/Tablebase.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+using namespace std;
+
+//--------------------------------------- Rules
+
+void TablebaseRules::moves(const TablebaseState& s, vector<int>& out) const {
+    for (int i = 0; i < 9; i++)
+        if (s.cells[i] == blank()) out.push_back(i);
+}
+
+char TablebaseRules::move_value(const TablebaseState& s, int) const {
+    return s.filled % 2 == 0 ? 'X' : 'O';
+}
+
+TablebaseState TablebaseRules::from_matrix(const vector<vector<char>>& b) const {
+    TablebaseState s;
+    for (int i = 0; i < 9; i++) {
+        auto [x, y] = cell(i);
+        s.cells[i] = static_cast<char>(toupper(static_cast<unsigned char>(b[x][y])));
+        if (s.cells[i] != blank()) s.filled++;
+    }
+    return s;
+}
+
+uint32_t TablebaseRules::key(const TablebaseState& s) const {
+    uint32_t k = 0;
+    for (int i = 0; i < 9; i++) k = k * radix() + digit(s.cells[i]);
+    return k;
+}
+
+int TablebaseRules::symmetric_cell(int t, int i) const {
+    static const BoardSymmetry square(3);
+    return square.cell(t, i);
+}
+
+TablebaseState TablebaseRules::canonical(const TablebaseState& s, int& t) const {
+    TablebaseState best = s;
+    uint32_t best_key = key(s);
+    t = 0;
+    for (int k = 1; k < symmetries(); k++) {
+        TablebaseState candidate = s;
+        for (int i = 0; i < 9; i++) candidate.cells[i] = s.cells[symmetric_cell(k, i)];
+        uint32_t candidate_key = key(candidate);
+        if (candidate_key < best_key) {
+            best = candidate;
+            best_key = candidate_key;
+            t = k;
+        }
+    }
+    return best;
+}
+
+/// Cells of the 8 lines of a 3x3 board, cell index = x * 3 + y.
+static const int XO_LINE_CELLS[8][3] = {
+    {0, 1, 2}, {3, 4, 5}, {6, 7, 8},
+    {0, 3, 6}, {1, 4, 7}, {2, 5, 8},
+    {0, 4, 8}, {2, 4, 6}
+};
+
+/// Symbol of the player who made the last move (X moves first).
+static char last_mover(const TablebaseState& s) {
+    return s.filled % 2 == 1 ? 'X' : 'O';
+}
+
+static bool owns_line(const TablebaseState& s, const int (*lines)[3], int n, char symbol) {
+    for (int k = 0; k < n; k++)
+        if (s.cells[lines[k][0]] == symbol && s.cells[lines[k][1]] == symbol && s.cells[lines[k][2]] == symbol)
+            return true;
+    return false;
+}
+
+/**
+ * @brief Misere X-O: completing a line loses.
+ */
+class MisereTablebaseRules : public TablebaseRules {
+public:
+    string name() const override { return "misere"; }
+
+    Result result(const TablebaseState& s) const override {
+        if (owns_line(s, XO_LINE_CELLS, 8, last_mover(s))) return MOVER_LOSES;
+        return s.filled == 9 ? DRAW : ONGOING;
+    }
+};
+
+/**
+ * @brief Memory X-O: plain X-O rules, the board is only hidden from the players.
+ */
+class MemoryTablebaseRules : public TablebaseRules {
+public:
+    string name() const override { return "memory"; }
+
+    Result result(const TablebaseState& s) const override {
+        if (owns_line(s, XO_LINE_CELLS, 8, last_mover(s))) return MOVER_WINS;
+        return s.filled == 9 ? DRAW : ONGOING;
+    }
+};
+
+/**
+ * @brief Pyramid X-O on the 9 cells of the pyramid.
+ */
+class PyramidTablebaseRules : public TablebaseRules {
+    /// Cells top to bottom, left to right: (0,2) (1,1) (1,2) (1,3) (2,0) ... (2,4).
+    static constexpr int CELLS[9][2] = {{0, 2}, {1, 1}, {1, 2}, {1, 3}, {2, 0}, {2, 1}, {2, 2}, {2, 3}, {2, 4}};
+    /// Cell of the left-right mirror image.
+    static constexpr int MIRROR[9] = {0, 3, 2, 1, 8, 7, 6, 5, 4};
+    static constexpr int LINES[7][3] = {
+        {0, 2, 6},                        // middle column
+        {1, 2, 3},                        // 2nd row
+        {4, 5, 6}, {5, 6, 7}, {6, 7, 8},  // 3rd row
+        {0, 1, 4}, {0, 3, 8}              // diagonals
+    };
+
+public:
+    string name() const override { return "pyramid"; }
+
+    pair<int, int> cell(int i) const override { return {CELLS[i][0], CELLS[i][1]}; }
+
+    int symmetries() const override { return 2; }
+
+    int symmetric_cell(int t, int i) const override { return t ? MIRROR[i] : i; }
+
+    Result result(const TablebaseState& s) const override {
+        if (owns_line(s, LINES, 7, last_mover(s))) return MOVER_WINS;
+        return s.filled == 9 ? DRAW : ONGOING;
+    }
+};
+
+/**
+ * @brief S-U-S: either player writes S or U, the move that leaves an odd number of S-U-S lines wins.
+ */
+class SUSTablebaseRules : public TablebaseRules {
+public:
+    string name() const override { return "sus"; }
+
+    int digit(char c) const override { return c == 'S' ? 1 : (c == 'U' ? 2 : 0); }
+
+    void moves(const TablebaseState& s, vector<int>& out) const override {
+        for (int i = 0; i < 9; i++)
+            if (s.cells[i] == blank()) {
+                out.push_back(i * 2);     // S
+                out.push_back(i * 2 + 1); // U
+            }
+    }
+
+    int move_cell(int move) const override { return move / 2; }
+
+    int move_on(int move, int cell) const override { return cell * 2 + move % 2; }
+
+    char move_value(const TablebaseState&, int move) const override { return move % 2 ? 'U' : 'S'; }
+
+    Result result(const TablebaseState& s) const override {
+        int score = 0;
+        for (auto& l : XO_LINE_CELLS)
+            if (s.cells[l[0]] == 'S' && s.cells[l[1]] == 'U' && s.cells[l[2]] == 'S') score++;
+        if (score % 2 == 1) return MOVER_WINS;
+        return s.filled == 9 ? DRAW : ONGOING;
+    }
+};
+
+/**
+ * @brief Numerical X-O: X writes odd digits, O even ones, each at most once; a line summing to 15 wins.
+ *
+ * As on the board, a line counts with its empty cells as 0.
+ */
+class NumericalTablebaseRules : public TablebaseRules {
+public:
+    string name() const override { return "numerical"; }
+
+    char blank() const override { return '0'; }
+
+    int radix() const override { return 10; }
+
+    int digit(char c) const override { return c - '0'; }
+
+    void moves(const TablebaseState& s, vector<int>& out) const override {
+        bool used[10] = {false};
+        for (char c : s.cells) used[c - '0'] = true;
+        int first = s.filled % 2 == 0 ? 1 : 2;
+        for (int i = 0; i < 9; i++) {
+            if (s.cells[i] != blank()) continue;
+            for (int d = first; d <= 9; d += 2)
+                if (!used[d]) out.push_back(i * 10 + d);
+        }
+    }
+
+    int move_cell(int move) const override { return move / 10; }
+
+    int move_on(int move, int cell) const override { return cell * 10 + move % 10; }
+
+    char move_value(const TablebaseState&, int move) const override { return static_cast<char>('0' + move % 10); }
+
+    Result result(const TablebaseState& s) const override {
+        for (auto& l : XO_LINE_CELLS)
+            if (digit(s.cells[l[0]]) + digit(s.cells[l[1]]) + digit(s.cells[l[2]]) == 15) return MOVER_WINS;
+        return s.filled == 9 ? DRAW : ONGOING;
+    }
+};
+
+vector<shared_ptr<const TablebaseRules>> tablebase_rules() {
+    return {
+        make_shared<MisereTablebaseRules>(),
+        make_shared<PyramidTablebaseRules>(),
+        make_shared<SUSTablebaseRules>(),
+        make_shared<NumericalTablebaseRules>(),
+        make_shared<MemoryTablebaseRules>()
+    };
+}
+
+shared_ptr<const TablebaseRules> find_tablebase_rules(const string& name) {
+    for (auto& rules : tablebase_rules())
+        if (rules->name() == name) return rules;
+    return nullptr;
+}
+
+//--------------------------------------- Table
+
+static const char TABLEBASE_MAGIC[8] = {'B', 'G', 'F', 'T', 'B', '0', '0', '1'};
+
+bool Tablebase::lookup(uint32_t key, int& score, int& move) const {
+    auto it = lower_bound(keys.begin(), keys.end(), key);
+    if (it == keys.end() || *it != key) return false;
+    size_t i = it - keys.begin();
+    score = scores[i];
+    move = moves[i];
+    return true;
+}
+
+bool Tablebase::save(const string& path) const {
+    ofstream out(path, ios::binary);
+    if (!out) return false;
+    uint32_t count = keys.size();
+    out.write(TABLEBASE_MAGIC, sizeof(TABLEBASE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    out.write(reinterpret_cast<const char*>(keys.data()), count * sizeof(uint32_t));
+    out.write(reinterpret_cast<const char*>(scores.data()), count);
+    out.write(reinterpret_cast<const char*>(moves.data()), count);
+    return static_cast<bool>(out);
+}
+
+bool Tablebase::load(const string& path) {
+    ifstream in(path, ios::binary);
+    if (!in) return false;
+    char magic[8];
+    uint32_t count = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!in || memcmp(magic, TABLEBASE_MAGIC, sizeof(magic)) != 0) return false;
+
+    keys.resize(count);
+    scores.resize(count);
+    moves.resize(count);
+    in.read(reinterpret_cast<char*>(keys.data()), count * sizeof(uint32_t));
+    in.read(reinterpret_cast<char*>(scores.data()), count);
+    in.read(reinterpret_cast<char*>(moves.data()), count);
+    if (!in) {
+        keys.clear();
+        scores.clear();
+        moves.clear();
+        return false;
+    }
+    return true;
+}
+
+shared_ptr<const Tablebase> Tablebase::find(const string& name) {
+    // Games of a self-play run share one copy; missing tables are remembered too
+    static mutex lock;
+    static map<string, shared_ptr<const Tablebase>> loaded;
+    lock_guard<mutex> guard(lock);
+    auto it = loaded.find(name);
+    if (it != loaded.end()) return it->second;
+
+    vector<string> dirs;
+    if (const char* env = getenv("BGF_TABLES")) dirs.push_back(env);
+    dirs.push_back("tables");
+    dirs.push_back("../tables");
+
+    shared_ptr<Tablebase> table;
+    for (auto& dir : dirs) {
+        auto candidate = make_shared<Tablebase>();
+        if (candidate->load(dir + "/" + name + ".tb")) {
+            table = candidate;
+            break;
+        }
+    }
+    loaded[name] = table;
+    return table;
+}
+
+//--------------------------------------- Player
+
+TablebasePlayer::TableMove TablebasePlayer::table_move() const {
+    TableMove result;
+    Board<char>* board_ptr = this->get_board_ptr();
+    if (!board_ptr) throw runtime_error("Board not assigned to player!");
+
+    TablebaseState s = rules->from_matrix(board_ptr->get_board_matrix());
+    int t, score, move;
+    TablebaseState canonical = rules->canonical(s, t);
+    if (!table->lookup(rules->key(canonical), score, move)) return result;
+
+    // The move was stored for the canonical form, play it on the matching cell of the board
+    move = rules->move_on(move, rules->symmetric_cell(t, rules->move_cell(move)));
+    auto [x, y] = rules->cell(rules->move_cell(move));
+    result.x = x;
+    result.y = y;
+    result.value = rules->move_value(s, move);
+    result.score = score;
+    return result;
+}
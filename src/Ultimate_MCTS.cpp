@@ -0,0 +1,225 @@
+//
+// Created by abdelhamid on 12/18/25.
+//
+
+#include "../include/Ultimate_MCTS.h"
+#include "../include/Ultimate_Tic_Tac_Toe.h"
+#include "../include/BitBoard.h"
+#include "../include/Parallel_Search.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace std;
+
+//--------------------------------------- Position
+
+static bool has_3x3_line(uint16_t mask) {
+    for (uint32_t line : XO_3X3_LINES)
+        if ((mask & line) == line) return true;
+    return false;
+}
+
+UltimateState UltimateState::from_boards(const vector<vector<char>>& board, const vector<vector<char>>& main, int to_move) {
+    UltimateState s;
+    for (int x = 0; x < 9; x++)
+        for (int y = 0; y < 9; y++) {
+            int side = BitBoard::xo_side(board[x][y]);
+            if (side < 0) continue;
+            s.cells[side][(x / 3) * 3 + y / 3] |= 1u << ((x % 3) * 3 + y % 3);
+            s.moves++;
+        }
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++) {
+            int side = BitBoard::xo_side(main[i][j]);
+            if (side >= 0) s.claimed[side] |= 1u << (i * 3 + j);
+        }
+    for (int side : {0, 1})
+        if (has_3x3_line(s.claimed[side])) s.winner = side;
+    s.to_move = to_move;
+    return s;
+}
+
+void UltimateState::play(int cell) {
+    int sub = cell / 9;
+    int side = to_move;
+    cells[side][sub] |= 1u << (cell % 9);
+    moves++;
+
+    // The first line in a sub-board claims it; only the mover's lines can have changed
+    uint16_t sub_bit = 1u << sub;
+    if (!((claimed[0] | claimed[1]) & sub_bit) && has_3x3_line(cells[side][sub])) {
+        claimed[side] |= sub_bit;
+        if (has_3x3_line(claimed[side])) winner = side;
+    }
+    to_move ^= 1;
+}
+
+/// xorshift64* step, one generator per search thread.
+static uint32_t next_random(uint64_t& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return static_cast<uint32_t>((state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+//--------------------------------------- Tree
+
+void UltimateMCTSPlayer::set_pool_size(int nodes) {
+    pool_size = nodes;
+    pool.reset();
+}
+
+void UltimateMCTSPlayer::reset_tree() {
+    if (!pool) pool.reset(new MCTSNode[pool_size]);
+    int used = min(pool_used.load(), pool_size);
+    for (int i = 0; i < max(used, 1); i++) {
+        MCTSNode& n = pool[i];
+        n.visits.store(0, memory_order_relaxed);
+        n.score.store(0, memory_order_relaxed);
+        n.first_child = -1;
+        n.child_count = 0;
+        n.move = 0;
+        n.state.store(0, memory_order_relaxed);
+    }
+    pool_used = 1; // node 0 is the root
+}
+
+bool UltimateMCTSPlayer::expand(MCTSNode& node, const UltimateState& s) {
+    // Pool is full: the node stays a leaf and keeps being evaluated by playouts
+    int count = 81 - s.moves;
+    int first = pool_used.load(memory_order_relaxed);
+    if (first + count > pool_size) return false;
+
+    uint8_t leaf = 0;
+    if (!node.state.compare_exchange_strong(leaf, 1, memory_order_acq_rel)) return false;
+
+    // Reserve the children, never past the end of the pool
+    do {
+        if (first + count > pool_size) {
+            node.state.store(0, memory_order_release);
+            return false;
+        }
+    } while (!pool_used.compare_exchange_weak(first, first + count, memory_order_relaxed));
+
+    int k = first;
+    for (int cell = 0; cell < 81; cell++)
+        if (s.empty(cell)) pool[k++].move = static_cast<uint8_t>(cell);
+    node.first_child = first;
+    node.child_count = static_cast<uint8_t>(count);
+    node.state.store(2, memory_order_release);
+    return true;
+}
+
+MCTSNode& UltimateMCTSPlayer::select_child(MCTSNode& node) {
+    double log_parent = log(static_cast<double>(max(node.visits.load(memory_order_relaxed), 1)));
+    MCTSNode* best = nullptr;
+    double best_value = -1.0;
+    for (int i = 0; i < node.child_count; i++) {
+        MCTSNode& child = pool[node.first_child + i];
+        int visits = child.visits.load(memory_order_relaxed);
+        if (visits == 0) return child; // every child is tried once first
+        double value = child.score.load(memory_order_relaxed) / (2.0 * visits)
+                     + exploration * sqrt(log_parent / visits);
+        if (value > best_value) {
+            best_value = value;
+            best = &child;
+        }
+    }
+    return *best;
+}
+
+void UltimateMCTSPlayer::iterate(const UltimateState& root, uint64_t& rng) {
+    UltimateState s = root;
+    MCTSNode* path[82];
+    int depth = 0;
+
+    // Selection and expansion. Visits are counted on the way down (virtual loss).
+    MCTSNode* node = &pool[0];
+    node->visits.fetch_add(1, memory_order_relaxed);
+    path[depth++] = node;
+    while (!s.over()) {
+        if (node->state.load(memory_order_acquire) != 2) {
+            // A leaf is expanded once it has had a playout of its own
+            if (node->visits.load(memory_order_relaxed) < 2 && depth > 1) break;
+            if (!expand(*node, s)) break;
+        }
+        MCTSNode& child = select_child(*node);
+        int visits = child.visits.fetch_add(1, memory_order_relaxed);
+        s.play(child.move);
+        node = &child;
+        path[depth++] = node;
+        if (visits == 0) break; // new node: evaluate it with a playout
+    }
+
+    // Playout: random empty cells until the game ends
+    if (!s.over()) {
+        uint8_t empty[81];
+        int n = 0;
+        for (int sub = 0; sub < 9; sub++) {
+            uint16_t free_cells = ~(s.cells[0][sub] | s.cells[1][sub]) & 0x1FF;
+            for (int pos = 0; pos < 9; pos++)
+                if (free_cells & (1u << pos)) empty[n++] = static_cast<uint8_t>(sub * 9 + pos);
+        }
+        while (!s.over()) {
+            int r = next_random(rng) % n;
+            int cell = empty[r];
+            empty[r] = empty[--n];
+            s.play(cell);
+        }
+    }
+
+    // Backup: node i was reached by a move of side (root side + i - 1)
+    for (int i = 0; i < depth; i++) {
+        int mover = (root.to_move + i + 1) & 1;
+        int reward = s.winner < 0 ? 1 : (s.winner == mover ? 2 : 0);
+        path[i]->score.fetch_add(reward, memory_order_relaxed);
+    }
+}
+
+pair<int, int> UltimateMCTSPlayer::calculateMove() {
+    auto ultimate = dynamic_cast<Ultimate_XO_Board*>(this->get_board_ptr());
+    if (!ultimate) throw runtime_error("Ultimate board not assigned to player!");
+
+    UltimateState root = UltimateState::from_boards(ultimate->get_board_matrix(),
+                                                    ultimate->get_main_board_matrix(),
+                                                    BitBoard::xo_side(this->get_symbol()));
+    if (root.over()) return {-1, -1};
+
+    reset_tree();
+    expand(pool[0], root);
+    MCTSNode& root_node = pool[0];
+
+    if (root_node.child_count > 1) {
+        auto deadline = chrono::steady_clock::now() + chrono::milliseconds(time_budget_ms);
+        atomic<int> playouts{0};
+        atomic<bool> stop{false};
+
+        auto work = [&](int worker) {
+            uint64_t rng = 0x9E3779B97F4A7C15ULL * (worker + 1)
+                         ^ static_cast<uint64_t>(chrono::steady_clock::now().time_since_epoch().count());
+            for (int i = 1; !stop.load(memory_order_relaxed); i++) {
+                iterate(root, rng);
+                if (playout_budget > 0 && playouts.fetch_add(1, memory_order_relaxed) + 1 >= playout_budget)
+                    stop = true;
+                if ((i & 63) == 0 && chrono::steady_clock::now() >= deadline) stop = true;
+            }
+        };
+
+        int threads = resolve_search_threads(search_threads);
+        vector<thread> pool_threads;
+        for (int w = 1; w < threads; w++) pool_threads.emplace_back(work, w);
+        work(0);
+        for (auto& t : pool_threads) t.join();
+    }
+
+    // Most visited move: the most robust choice
+    MCTSNode* best = &pool[root_node.first_child];
+    for (int i = 1; i < root_node.child_count; i++) {
+        MCTSNode& child = pool[root_node.first_child + i];
+        if (child.visits.load() > best->visits.load()) best = &child;
+    }
+
+    int sub = best->move / 9, pos = best->move % 9;
+    return {(sub / 3) * 3 + pos / 3, (sub % 3) * 3 + pos % 3};
+}
@@ -3,6 +3,7 @@
 //
 
 #include "../include/Ultimate_Tic_Tac_Toe.h"
+#include "../include/Ultimate_MCTS.h"
 
 //===========main Board Implementation===============
 mainBoard::mainBoard() :Board<char>(3,3) {
@@ -21,32 +22,16 @@ bool mainBoard::update_board(Move<char>* move) {
     // Validate move and apply if valid
     if (!(x < 0 || x >= rows || y < 0 || y >= columns) && (board[x][y] == blank_symbol)) {
         board[x][y] = toupper(mark);
+        int side = BitBoard::xo_side(mark);
+        if (side >= 0) bits.set(x, y, side);
         n_moves++;
         return true;
     }
     return false;
 }
 
-bool mainBoard::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
-
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a != blank_symbol;
-    };
-
-    // Check rows and columns
-    for (int i = 0; i < rows; ++i) {
-        if ((all_equal(board[i][0], board[i][1], board[i][2]) && board[i][0] == sym) ||
-            (all_equal(board[0][i], board[1][i], board[2][i]) && board[0][i] == sym))
-            return true;
-    }
-
-    // Check diagonals
-    if ((all_equal(board[0][0], board[1][1], board[2][2]) && board[1][1] == sym) ||
-        (all_equal(board[0][2], board[1][1], board[2][0]) && board[1][1] == sym))
-        return true;
-
-    return false;
+bool mainBoard::is_win(char symbol) {
+    return bits.has_line(BitBoard::xo_side(symbol), XO_3X3_LINES, 8);
 }
 
 bool mainBoard::is_draw(Player<char>* player) {
@@ -57,6 +42,32 @@ bool mainBoard::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+// Everything the main board needs, copied as is
+struct MainBoardState {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("ULTM");
+    char cells[3][3];
+    int n_moves;
+    BitBoard bits;
+};
+
+bool mainBoard::snapshot(BoardSnapshot& s) const {
+    MainBoardState st;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    st.bits = bits;
+    s.store(st);
+    return true;
+}
+
+bool mainBoard::restore(const BoardSnapshot& s) {
+    MainBoardState st;
+    if (!s.load(st)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    bits = st.bits;
+    return true;
+}
+
 //================Ultimate Board Implementation================
 
 Ultimate_XO_Board::Ultimate_XO_Board() : Board<char> (9,9 ) {
@@ -103,21 +114,48 @@ bool Ultimate_XO_Board::update_board(Move<char>* move) {
     return false;
 }
 
-bool Ultimate_XO_Board::is_win(Player<char>* player) {
-
-    if (mainBoardPtr->is_win(player)) return true;
-
-    return false;
+bool Ultimate_XO_Board::is_win(char symbol) {
+    return mainBoardPtr->is_win(symbol);
 }
 
 bool Ultimate_XO_Board::is_draw(Player<char>* player) {
-    return (n_moves == 81 && mainBoardPtr->is_draw(player));
+    // A full board ends the game even if some sub-boards were never claimed
+    return (n_moves == 81 && !is_win(player));
 }
 
 bool Ultimate_XO_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+// The 9x9 cells followed by the main board's state
+struct UltimateBoardState {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("ULTB");
+    char cells[9][9];
+    int n_moves;
+    MainBoardState main;
+};
+
+bool Ultimate_XO_Board::snapshot(BoardSnapshot& s) const {
+    UltimateBoardState st;
+    BoardSnapshot main;
+    if (!mainBoardPtr->snapshot(main) || !main.load(st.main)) return false;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    s.store(st);
+    return true;
+}
+
+bool Ultimate_XO_Board::restore(const BoardSnapshot& s) {
+    UltimateBoardState st;
+    if (!s.load(st)) return false;
+    BoardSnapshot main;
+    main.store(st.main);
+    if (!mainBoardPtr->restore(main)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    return true;
+}
+
 
 
 // ---------------------- UI ----------------------
@@ -143,6 +181,7 @@ Player<char>* Ultimate_XO_UI::create_player(string& name, char symbol, PlayerTyp
     cout << "Creating " << (type == PlayerType::HUMAN ? "human" : "computer")
         << " player: " << name << " (" << symbol << ")\n";
 
+    if (type == PlayerType::COMPUTER) return new UltimateMCTSPlayer(name, symbol, type);
     return new Player<char>(name, symbol, type);
 }
 
@@ -154,6 +193,11 @@ Move<char>* Ultimate_XO_UI::get_move(Player<char>* player) {
         cout << "\nPlease enter your move x and y (0 to 8): ";
         cin >> x >> y;
     }
+    else if (auto mcts = dynamic_cast<UltimateMCTSPlayer*>(player)) {
+        auto move = mcts->calculateMove();
+        x = move.first;
+        y = move.second;
+    }
     else if (player->get_type() == PlayerType::COMPUTER) {
         x = rand() % player->get_board_ptr()->get_rows();
         y = rand() % player->get_board_ptr()->get_columns();
@@ -0,0 +1,255 @@
+//
+// Created by abdelhamid on 12/19/25.
+//
+
+#include "../include/Word_Dictionary.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BGF_HAVE_MMAP 1
+#endif
+
+using namespace std;
+
+static const char DICTIONARY_MAGIC[8] = {'B', 'G', 'F', 'D', 'I', 'C', '0', '2'};
+
+/// Header of a compiled dictionary, followed by the three-letter tables and the nodes.
+struct DictionaryHeader {
+    char magic[8];
+    uint32_t nodes;
+    uint32_t words;
+    uint32_t letters;
+    uint32_t reserved;
+};
+
+// Byte sizes of the three-letter tables in a compiled file (the nodes stay 4-byte aligned)
+static const size_t TRIPLE_BYTES = ((26 * 26 * 26 + 63) / 64) * sizeof(uint64_t);
+static const size_t PATTERN_BYTES = (27 * 27 * 27 * sizeof(uint16_t) + 3) & ~size_t(3);
+
+WordDictionary::~WordDictionary() {
+#ifdef BGF_HAVE_MMAP
+    if (mapping) munmap(mapping, mapping_size);
+#endif
+}
+
+void WordDictionary::insert(const string& word) {
+    for (char c : word)
+        if (!isalpha(static_cast<unsigned char>(c))) return;
+    if (word.empty()) return;
+
+    if (mapped) {
+        // A mapped file is read-only: continue on a copy
+        owned.assign(mapped, mapped + mapped_nodes);
+        owned_triples.assign(triples, triples + owned_triples.size());
+        owned_patterns.assign(patterns, patterns + owned_patterns.size());
+        mapped = nullptr;
+        triples = owned_triples.data();
+        patterns = owned_patterns.data();
+    }
+
+    int node = 0;
+    for (char c : word) {
+        int letter = toupper(static_cast<unsigned char>(c)) - 'A';
+        if (owned[node].next[letter] < 0) {
+            owned[node].next[letter] = owned.size();
+            owned.emplace_back();
+        }
+        node = owned[node].next[letter];
+
+        char upper = static_cast<char>('A' + letter);
+        if (used_letters.find(upper) == string::npos) {
+            auto pos = lower_bound(used_letters.begin(), used_letters.end(), upper);
+            used_letters.insert(pos, upper);
+        }
+    }
+    if (owned[node].word) return;
+    owned[node].word = 1;
+    words++;
+
+    if (word.size() == 3) {
+        int letter[3];
+        for (int i = 0; i < 3; i++) letter[i] = toupper(static_cast<unsigned char>(word[i])) - 'A';
+        int key = (letter[0] * 26 + letter[1]) * 26 + letter[2];
+        owned_triples[key >> 6] |= uint64_t(1) << (key & 63);
+        // Every way of blanking some of the three cells
+        for (int blanks = 0; blanks < 8; blanks++) {
+            int pattern = 0;
+            for (int i = 0; i < 3; i++) pattern = pattern * 27 + ((blanks >> i) & 1 ? 26 : letter[i]);
+            owned_patterns[pattern]++;
+        }
+    }
+}
+
+bool WordDictionary::load(const string& path) {
+    ifstream f(path);
+    if (!f.is_open()) return false;
+    string line;
+    while (getline(f, line)) {
+        // trim
+        size_t s = 0, e = line.size();
+        while (s < e && isspace((unsigned char)line[s])) ++s;
+        while (e > s && isspace((unsigned char)line[e-1])) --e;
+        if (e > s) insert(line.substr(s, e - s));
+    }
+    return true;
+}
+
+bool WordDictionary::save_compiled(const string& path) const {
+    ofstream out(path, ios::binary);
+    if (!out) return false;
+    DictionaryHeader header{};
+    memcpy(header.magic, DICTIONARY_MAGIC, sizeof(header.magic));
+    header.nodes = mapped ? mapped_nodes : owned.size();
+    header.words = words;
+    for (char c : used_letters) header.letters |= 1u << (c - 'A');
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(triples), TRIPLE_BYTES);
+    vector<char> pattern_bytes(PATTERN_BYTES);
+    memcpy(pattern_bytes.data(), patterns, PATTERNS * sizeof(uint16_t));
+    out.write(pattern_bytes.data(), PATTERN_BYTES);
+    out.write(reinterpret_cast<const char*>(nodes()), header.nodes * sizeof(Node));
+    return static_cast<bool>(out);
+}
+
+bool WordDictionary::load_compiled(const string& path) {
+    DictionaryHeader header;
+    size_t file_size = 0;
+    const size_t tables = sizeof(header) + TRIPLE_BYTES + PATTERN_BYTES;
+
+#ifdef BGF_HAVE_MMAP
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(header)) {
+        file_size = st.st_size;
+        data = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd); // the mapping stays valid
+    if (data == MAP_FAILED) return false;
+    memcpy(&header, data, sizeof(header));
+#else
+    ifstream in(path, ios::binary | ios::ate);
+    if (!in) return false;
+    file_size = in.tellg();
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+#endif
+
+    bool valid = memcmp(header.magic, DICTIONARY_MAGIC, sizeof(header.magic)) == 0
+                 && header.nodes > 0
+                 && file_size == tables + static_cast<size_t>(header.nodes) * sizeof(Node);
+    if (!valid) {
+#ifdef BGF_HAVE_MMAP
+        munmap(data, file_size);
+#endif
+        return false;
+    }
+
+#ifdef BGF_HAVE_MMAP
+    if (mapping) munmap(mapping, mapping_size);
+    const char* bytes = static_cast<const char*>(data);
+    mapping = data;
+    mapping_size = file_size;
+    triples = reinterpret_cast<const uint64_t*>(bytes + sizeof(header));
+    patterns = reinterpret_cast<const uint16_t*>(bytes + sizeof(header) + TRIPLE_BYTES);
+    mapped = reinterpret_cast<const Node*>(bytes + tables);
+    mapped_nodes = header.nodes;
+    owned.assign(1, Node());
+#else
+    vector<char> pattern_bytes(PATTERN_BYTES);
+    owned.resize(header.nodes);
+    in.read(reinterpret_cast<char*>(owned_triples.data()), TRIPLE_BYTES);
+    in.read(pattern_bytes.data(), PATTERN_BYTES);
+    in.read(reinterpret_cast<char*>(owned.data()), header.nodes * sizeof(Node));
+    if (!in) {
+        owned.assign(1, Node());
+        fill(owned_triples.begin(), owned_triples.end(), 0);
+        return false;
+    }
+    memcpy(owned_patterns.data(), pattern_bytes.data(), PATTERNS * sizeof(uint16_t));
+#endif
+
+    words = header.words;
+    used_letters.clear();
+    for (int i = 0; i < 26; i++)
+        if (header.letters & (1u << i)) used_letters += static_cast<char>('A' + i);
+    return true;
+}
+
+bool WordDictionary::contains(const string& word) const {
+    if (word.size() == 3) {
+        char up[3];
+        for (int i = 0; i < 3; i++) up[i] = static_cast<char>(toupper(static_cast<unsigned char>(word[i])));
+        return is_word(up[0], up[1], up[2]);
+    }
+    const Node* n = nodes();
+    int node = 0;
+    for (char c : word) {
+        if (!isalpha(static_cast<unsigned char>(c))) return false;
+        node = n[node].next[toupper(static_cast<unsigned char>(c)) - 'A'];
+        if (node < 0) return false;
+    }
+    return n[node].word != 0;
+}
+
+bool WordDictionary::match(int node, const string& pattern, size_t i, char blank) const {
+    const Node& n = nodes()[node];
+    if (i == pattern.size()) return n.word != 0;
+    char c = pattern[i];
+    if (c == blank) {
+        for (int next : n.next)
+            if (next >= 0 && match(next, pattern, i + 1, blank)) return true;
+        return false;
+    }
+    if (!isalpha(static_cast<unsigned char>(c))) return false;
+    int next = n.next[toupper(static_cast<unsigned char>(c)) - 'A'];
+    return next >= 0 && match(next, pattern, i + 1, blank);
+}
+
+bool WordDictionary::can_complete(const string& pattern, char blank) const {
+    if (pattern.size() == 3) {
+        char up[3];
+        for (int i = 0; i < 3; i++)
+            up[i] = pattern[i] == blank ? blank : static_cast<char>(toupper(static_cast<unsigned char>(pattern[i])));
+        return completions(up[0], up[1], up[2], blank) > 0;
+    }
+    return match(0, pattern, 0, blank);
+}
+
+shared_ptr<const WordDictionary> WordDictionary::shared(const string& path) {
+    // Boards and players of games running on several threads (bgf_selfplay) share one copy
+    static mutex lock;
+    static map<string, shared_ptr<const WordDictionary>> loaded;
+    lock_guard<mutex> guard(lock);
+    auto it = loaded.find(path);
+    if (it != loaded.end()) return it->second;
+
+    auto dictionary = make_shared<WordDictionary>();
+    bool compiled = path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+    if (!(compiled ? dictionary->load_compiled(path) : dictionary->load(path)))
+        cerr << "Warning: cannot open " << path << "\n";
+    loaded[path] = dictionary;
+    return dictionary;
+}
+
+shared_ptr<const WordDictionary> WordDictionary::shared() {
+    static const string path = [] {
+        if (const char* env = getenv("BGF_DICT")) return string(env);
+        for (const char* candidate : {"dic.bin", "../dic.bin", "dic.txt", "../dic.txt"})
+            if (ifstream(candidate)) return string(candidate);
+        return string("../dic.txt");
+    }();
+    return shared(path);
+}
@@ -1,11 +1,10 @@
 #include <iostream>
-#include <unordered_set>
 #include <iomanip>
 #include <cctype>  // for toupper()
 #include <random>
-#include <fstream>
 #include "../include/Words_XO.h"
 #include "../include/Smart_Player.h"
+#include "../include/Word_Dictionary.h"
 
 
 using namespace std;
@@ -16,122 +15,96 @@ const vector<char> LETTERS = {
     'U','V','W','X','Y','Z'
 };
 
+// Cells of each line, in the same order as XO_3X3_LINES
+static const int WORD_LINE_CELLS[8][3][2] = {
+    {{0,0},{0,1},{0,2}}, {{1,0},{1,1},{1,2}}, {{2,0},{2,1},{2,2}},
+    {{0,0},{1,0},{2,0}}, {{0,1},{1,1},{2,1}}, {{0,2},{1,2},{2,2}},
+    {{0,0},{1,1},{2,2}}, {{0,2},{1,1},{2,0}}
+};
+
 class wordSmartPlayer : public smartPlayer<char> {
     using smartPlayer<char>::smartPlayer;
 
 protected:
-    vector<string> dictionary;
+    shared_ptr<const WordDictionary> dictionary; // shared with the board
     vector<char> possibleLetters;      // only letters that appear in the dictionary
     mutable unsigned long node_counter = 0; // count nodes visited (mutable to update in const funcs)
-    const unsigned long MAX_NODES = 10000; // tune this: 200k node budget as example
 
 
 public:
-    wordSmartPlayer(string n, char s, PlayerType t, const string& dictFile)
-            : smartPlayer<char>(n, s, t)
+    wordSmartPlayer(string n, char s, PlayerType t)
+            : smartPlayer<char>(n, s, t), dictionary(WordDictionary::shared())
     {
-        loadDictionary(dictFile);
-    }
-
-protected:
-    void loadDictionary(const string& filename) {
-        ifstream in(filename);
-        string w;
-        unordered_set<char> letters;
-        while (in >> w) {
-            // convert to uppercase and keep only alphabetic characters
-            for (char &ch : w) ch = toupper(static_cast<unsigned char>(ch));
-            dictionary.push_back(w);
-            for (char ch : w) if (isalpha((unsigned char)ch)) letters.insert(ch);
-        }
-        // build possibleLetters vector from set (stable order not required)
+        // A-Z if the dictionary is empty for whatever reason
+        string letters = dictionary->letters();
         possibleLetters.assign(letters.begin(), letters.end());
-        // if dictionary is empty for whatever reason, fall back to full alphabet
-        if (possibleLetters.empty()) {
-            possibleLetters = LETTERS;
-        }
     }
 
+    // The pondering thread calls the overrides below: stop it while they still exist
+    ~wordSmartPlayer() override { stop_pondering(); }
 
-    virtual bool is_win(const vector<vector<char>>& b, char s, int N = 3) const override {
-        int R = b.size();
-        int C = b[0].size();
-
-        // Check all rows
-        for (int i = 0; i < R; i++) {
-            string row;
-            for (int j = 0; j < C; j++) row += b[i][j];
-            if (is_valid_word(row)) return true;
-        }
-
-        // Check all columns
-        for (int j = 0; j < C; j++) {
-            string col;
-            for (int i = 0; i < R; i++) col += b[i][j];
-            if (is_valid_word(col)) return true;
-        }
-
-        // Check TL-BR diagonal
-        if (R == C) {
-            string diag;
-            for (int k = 0; k < R; k++) diag += b[k][k];
-            if (is_valid_word(diag)) return true;
-        }
+protected:
+    // Words that line k can still become (table lookup, blanks match any letter)
+    int line_completions(const vector<vector<char>>& b, int k) const {
+        auto& c = WORD_LINE_CELLS[k];
+        return dictionary->completions(b[c[0][0]][c[0][1]], b[c[1][0]][c[1][1]], b[c[2][0]][c[2][1]]);
+    }
 
-        // Check TR-BL diagonal
-        if (R == C) {
-            string diag;
-            for (int k = 0; k < R; k++) diag += b[k][C - 1 - k];
-            if (is_valid_word(diag)) return true;
+    // Whether a line through (i, j) can still become a word
+    bool line_live(const vector<vector<char>>& b, int i, int j) const {
+        for (int k = 0; k < 8; k++) {
+            auto& c = WORD_LINE_CELLS[k];
+            bool through = false;
+            for (int m = 0; m < 3; m++) through |= c[m][0] == i && c[m][1] == j;
+            if (through && line_completions(b, k) > 0) return true;
         }
-
         return false;
     }
 
-    bool is_valid_word(const string& s) const {
-        // remove '.' (empty cells)
-        string cleaned;
-        for (char c : s)
-            if (c != '.') cleaned += c;
-
-        if (cleaned.size() < 3) return false;
-
-        return find(dictionary.begin(), dictionary.end(), cleaned) != dictionary.end();
+    // Letters worth trying at empty cell (i, j): every letter that keeps a line through the cell
+    // alive, plus one letter that kills them all (any such letter leads to the same game)
+    void cell_letters(vector<vector<char>>& b, int i, int j, vector<char>& out) const {
+        out.clear();
+        bool dead_added = false;
+        for (char c : possibleLetters) {
+            b[i][j] = c;
+            bool live = line_live(b, i, j);
+            b[i][j] = '.';
+            if (live) out.push_back(c);
+            else if (!dead_added) {
+                out.push_back(c);
+                dead_added = true;
+            }
+        }
     }
 
-    virtual int evaluate_board(const vector<vector<char>>& b, char ai, char opp, int N = 3) const override {
-        // Scoring: more letters forming a prefix of any word = higher score
-        int score = 0;
 
-        for (auto& w : dictionary) {
-            score += score_line(b, w, ai);
-            score -= score_line(b, w, opp);
-        }
-
-        return score;
+    // A full line spelling a word: one bit lookup per line
+    virtual bool is_win(const vector<vector<char>>& b, char /*s*/, int /*N*/ = 3) const override {
+        for (auto& c : WORD_LINE_CELLS)
+            if (dictionary->is_word(b[c[0][0]][c[0][1]], b[c[1][0]][c[1][1]], b[c[2][0]][c[2][1]])) return true;
+        return false;
     }
 
-    int score_line(const vector<vector<char>>& b, const string& word, char symbol) const {
-        int R = b.size();
-        int C = b[0].size();
-        int score = 0;
-
-        // Example scoring: +10 for correct letter in position, +3 for empty, -5 otherwise
-        for (int i = 0; i < R; i++)
-            for (int j = 0; j < C; j++) {
-                // Check horizontal word match possibility
-                if (j + word.size() <= C) {
-                    int s = 0;
-                    for (int k = 0; k < word.size(); k++) {
-                        if (b[i][j+k] == word[k]) s += 10;
-                        else if (b[i][j+k] == '.') s += 3;
-                        else { s = -50; break; }
-                    }
-                    score += s;
-                }
-            }
+    virtual int evaluate_board(const vector<vector<char>>& b, char ai, char /*opp*/, int /*N*/ = 3) const override {
+        // Letters belong to nobody, so prefix scores would cancel out. What the position does say:
+        // a line missing one letter that can still become a word is won by the side to move.
+        int filled = 0;
+        for (auto& row : b)
+            for (char cell : row)
+                if (cell != '.') filled++;
+
+        bool threat = false;
+        for (int k = 0; k < 8 && !threat; k++) {
+            int blanks = 0;
+            for (auto& c : WORD_LINE_CELLS[k]) blanks += b[c[0]][c[1]] == '.';
+            threat = blanks == 1 && line_completions(b, k) > 0;
+        }
+        if (!threat) return 0;
 
-        return score;
+        // X moves first
+        bool ai_to_move = (filled % 2 == 0) == (toupper(ai) == 'X');
+        return ai_to_move ? 500 : -500;
     }
 
     int minimax(vector<vector<char>>& b,
@@ -145,25 +118,33 @@ protected:
 {
     // node accounting
     ++node_counter;
-    if (node_counter > MAX_NODES) {
+    SearchCounters& counters = thread_search_counters();
+    counters.nodes++;
+    if (time_up()) {
         // abort search early: return heuristic evaluation to let caller use partial result
         return evaluate_board(b, ai, opp, N);
     }
 
-    if (is_win(b, ai, N)) return 1000 + depth; // prefer faster win
-    if (is_win(b, opp, N)) return -1000 - depth; // prefer slower loss
+    // Letters belong to nobody: a word on the board was made by the player who just moved
+    if (is_win(b, ai, N)) return maximizingPlayer ? -1000 - depth : 1000 + depth; // prefer faster win, slower loss
     if (is_draw(b, N)) return 0;
-    if (depth == 0) return evaluate_board(b, ai, opp, N);
+    if (depth == 0) {
+        counters.leaves++;
+        return evaluate_board(b, ai, opp, N);
+    }
 
     int rows = b.size();
     int cols = b[0].size();
+    int tried = 0; // index of the move being searched, for the cutoff statistics
+    vector<char> letters;
 
     if (maximizingPlayer) {
         int best = numeric_limits<int>::min();
         for (int i = 0; i < rows; ++i) {
             for (int j = 0; j < cols; ++j) {
                 if (b[i][j] != '.') continue;
-                for (char c : possibleLetters) {
+                cell_letters(b, i, j, letters);
+                for (char c : letters) {
                     b[i][j] = c;
                     int val = minimax(b, false, ai, opp, alpha, beta, depth - 1, N);
                     b[i][j] = '.';
@@ -171,10 +152,12 @@ protected:
                     if (best > alpha) alpha = best;
                     if (beta <= alpha) {
                         // pruning - break out early
+                        counters.cutoff(tried);
                         goto OUT_MAX_LOOP;
                     }
-                    // early node budget check
-                    if (node_counter > MAX_NODES) goto OUT_MAX_LOOP;
+                    tried++;
+                    // early time budget check
+                    if (search_aborted) goto OUT_MAX_LOOP;
                 }
             }
         }
@@ -185,16 +168,19 @@ OUT_MAX_LOOP:
         for (int i = 0; i < rows; ++i) {
             for (int j = 0; j < cols; ++j) {
                 if (b[i][j] != '.') continue;
-                for (char c : possibleLetters) {
+                cell_letters(b, i, j, letters);
+                for (char c : letters) {
                     b[i][j] = c;
                     int val = minimax(b, true, ai, opp, alpha, beta, depth - 1, N);
                     b[i][j] = '.';
                     if (val < best) best = val;
                     if (best < beta) beta = best;
                     if (beta <= alpha) {
+                        counters.cutoff(tried);
                         goto OUT_MIN_LOOP;
                     }
-                    if (node_counter > MAX_NODES) goto OUT_MIN_LOOP;
+                    tried++;
+                    if (search_aborted) goto OUT_MIN_LOOP;
                 }
             }
         }
@@ -208,90 +194,92 @@ public:
         Board<char>* board_ptr = this->get_board_ptr();
         if (!board_ptr) throw runtime_error("Board not assigned to player!");
 
+        auto begin = chrono::steady_clock::now();
+        SearchStats move_stats;
         auto tempBoard = board_ptr->get_board_matrix();
         int rows = tempBoard.size();
         int cols = tempBoard[0].size();
 
-        int bestVal = numeric_limits<int>::min();
         int bestX = -1, bestY = -1;
         char bestc = '#';
 
         char ai = this->get_symbol();
         char opp = get_opponent_symbol();
 
-        // search configuration
-        int maxDepth = 1; // can drop to 1 if slow; raise if you add pruning/time limits
-        node_counter = 0; // reset before search
-
         // If possibleLetters empty (shouldn't be), fall back
         if (possibleLetters.empty()) possibleLetters = LETTERS;
 
-        for (int i = 0; i < rows; ++i) {
-            for (int j = 0; j < cols; ++j) {
-                if (tempBoard[i][j] != '.') continue;
-                for (char c : possibleLetters) {
-                    tempBoard[i][j] = c;
-                    int moveVal = minimax(tempBoard, false, ai, opp,
-                                          numeric_limits<int>::min(),
-                                          numeric_limits<int>::max(),
-                                          maxDepth);
-                    tempBoard[i][j] = '.';
-                    if (moveVal > bestVal) {
-                        bestVal = moveVal;
-                        bestX = i;
-                        bestY = j;
-                        bestc = c;
+        int empties = 0;
+        for (auto& row : tempBoard)
+            for (char cell : row)
+                if (cell == '.') empties++;
+
+        // Iterative deepening within the time budget, previous best (cell, letter) searched first
+        start_search_clock();
+        for (int maxDepth = 0; maxDepth < max_search_depth; maxDepth++) {
+            node_counter = 0; // reset before each iteration
+            int bestVal = numeric_limits<int>::min();
+            int iterX = -1, iterY = -1;
+            char iterc = '#';
+
+            auto search_root = [&](int i, int j, char c) {
+                tempBoard[i][j] = c;
+                int moveVal = count_search(move_stats.counters, [&] {
+                    return minimax(tempBoard, false, ai, opp,
+                                   bestVal,
+                                   numeric_limits<int>::max(),
+                                   maxDepth);
+                });
+                tempBoard[i][j] = '.';
+                if (moveVal > bestVal) {
+                    bestVal = moveVal;
+                    iterX = i;
+                    iterY = j;
+                    iterc = c;
+                }
+            };
+
+            if (bestX != -1) search_root(bestX, bestY, bestc);
+            for (int i = 0; i < rows && !search_aborted; ++i) {
+                for (int j = 0; j < cols && !search_aborted; ++j) {
+                    if (tempBoard[i][j] != '.') continue;
+                    vector<char> letters;
+                    cell_letters(tempBoard, i, j, letters);
+                    for (char c : letters) {
+                        if (i == bestX && j == bestY && c == bestc) continue;
+                        search_root(i, j, c);
+                        if (search_aborted) break;
                     }
-                    // optional: if node budget reached, break entirely
-                    if (node_counter > MAX_NODES) break;
                 }
-                if (node_counter > MAX_NODES) break;
             }
-            if (node_counter > MAX_NODES) break;
+
+            // An aborted iteration only counts if nothing has completed yet
+            if (search_aborted && bestX != -1) break;
+            bestX = iterX;
+            bestY = iterY;
+            bestc = iterc;
+            if (!search_aborted) move_stats.depth = maxDepth + 1;
+            if (search_aborted || bestVal >= 1000 || maxDepth + 1 >= empties) break;
         }
 
         // Debug: print nodes visited (remove in production)
         // cerr << "AI nodes visited: " << node_counter << ", bestVal=" << bestVal << "\n";
 
+        move_stats.elapsed_ns = elapsed_ns(begin);
+        stats.report(move_stats, get_name());
+
         return {{bestX, bestY}, bestc};
     }
 
 };
 
 
-static unordered_set<string> GLOBAL_DICT;
-static bool GLOBAL_DICT_LOADED = false;
-
-void load_global_dictionary(const string& path = "../dic.txt") {
-    if (GLOBAL_DICT_LOADED) return;
-    ifstream f(path);
-    if (!f.is_open()) {
-        cerr << "Warning: cannot open " << path << "\n";
-        GLOBAL_DICT_LOADED = true; // prevent repeated warnings
-        return;
-    }
-    string line;
-    while (getline(f, line)) {
-        // trim
-        size_t s = 0, e = line.size();
-        while (s < e && isspace((unsigned char)line[s])) ++s;
-        while (e > s && isspace((unsigned char)line[e-1])) --e;
-        if (e - s == 0) continue;
-        string w = line.substr(s, e - s);
-        for (char &c : w) c = toupper(static_cast<unsigned char>(c));
-        GLOBAL_DICT.insert(w);
-    }
-    GLOBAL_DICT_LOADED = true;
-}
-
-bool Check_word(const string& W) {
-    if (!GLOBAL_DICT_LOADED) load_global_dictionary("../dic.txt");
-    string t = W;
-    for (char &c : t) c = toupper(static_cast<unsigned char>(c));
-    return GLOBAL_DICT.count(t) > 0;
+static const WordDictionary& board_dictionary() {
+    // Same shared dictionary as the computer players
+    static shared_ptr<const WordDictionary> dictionary = WordDictionary::shared();
+    return *dictionary;
 }
 
-
 Word_XO_Board::Word_XO_Board() : Board(3, 3), counter(0) {
     // Initialize all cells with blank_symbol
     for (auto& row : board)
@@ -315,6 +303,18 @@ bool Word_XO_Board::update_board(Move<char>* move) {
 
         n_moves++;
         board[x][y] = toupper(val);
+        bits.set(x, y, 0);
+        last_symbol = toupper(ch);
+
+        // Only the lines through the new letter can have become words
+        uint32_t filled = bits.get_mask(0);
+        for (int k = 0; k < 8; k++) {
+            if (!(XO_3X3_LINES[k] & bits.bit(x, y))) continue;
+            if ((filled & XO_3X3_LINES[k]) != XO_3X3_LINES[k]) continue;
+            auto& c = WORD_LINE_CELLS[k];
+            if (board_dictionary().is_word(board[c[0][0]][c[0][1]], board[c[1][0]][c[1][1]], board[c[2][0]][c[2][1]]))
+                word_lines++;
+        }
 
         counter++;
 
@@ -324,30 +324,9 @@ bool Word_XO_Board::update_board(Move<char>* move) {
     return false;
 }
 
-bool Word_XO_Board::is_win(Player<char>* player) {
-    const char sym = player->get_symbol();
-
-    auto valid = [&](char a, char b, char c) {
-        if (a == '.' || b == '.' || c == '.') return false;
-        string s;
-        s.push_back(a);s.push_back(b);s.push_back(c);
-        // see if the word is in the file
-        return Check_word(s);
-    };
-
-    // Check rows and columns
-    for (int i = 0; i < rows; ++i) {
-        if ((valid(board[i][0], board[i][1], board[i][2])) ||
-            (valid(board[0][i], board[1][i], board[2][i])))
-            return true;
-    }
-
-    // Check diagonals
-    if ((valid(board[0][0], board[1][1], board[2][2])) ||
-        (valid(board[0][2], board[1][1], board[2][0])))
-        return true;
-
-    return false;
+bool Word_XO_Board::is_win(char symbol) {
+    // The first word ends the game, so it belongs to whoever moved last
+    return word_lines > 0 && toupper(symbol) == last_symbol;
 }
 
 bool Word_XO_Board::is_draw(Player<char>* player) {
@@ -358,6 +337,41 @@ bool Word_XO_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+// Everything a position needs, copied as is
+struct WordState {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("WORD");
+    char cells[3][3];
+    int n_moves;
+    int counter;
+    BitBoard bits;
+    int word_lines;
+    char last_symbol;
+};
+
+bool Word_XO_Board::snapshot(BoardSnapshot& s) const {
+    WordState st;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    st.counter = counter;
+    st.bits = bits;
+    st.word_lines = word_lines;
+    st.last_symbol = last_symbol;
+    s.store(st);
+    return true;
+}
+
+bool Word_XO_Board::restore(const BoardSnapshot& s) {
+    WordState st;
+    if (!s.load(st)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    counter = st.counter;
+    bits = st.bits;
+    word_lines = st.word_lines;
+    last_symbol = st.last_symbol;
+    return true;
+}
+
 //--------------------------------------- XO_UI Implementation
 
 Word_XO_UI::Word_XO_UI() : UI<char>("Weclome to FCAI Words X-O Game", 3) {}
@@ -369,9 +383,8 @@ Player<char>* Word_XO_UI::create_player(string& name, char symbol, PlayerType ty
     if (type == PlayerType::HUMAN) {
         return new Player<char>(name, symbol, type);
     } else {
-        // Construct a wordSmartPlayer and pass the dictionary file path
-        // Make sure "dic.txt" path is correct relative to your working dir
-        return new wordSmartPlayer(name, symbol, type, "../dic.txt");
+        // Uses the shared dictionary (dic.bin built next to the executable, or dic.txt)
+        return new wordSmartPlayer(name, symbol, type);
     }
 }
 
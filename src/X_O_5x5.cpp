@@ -5,10 +5,11 @@
 
 using namespace std;
 
-X_O_5x5_Board::X_O_5x5_Board() : Board(5, 5) , counter(0){
+X_O_5x5_Board::X_O_5x5_Board() : Board(5, 5) , counter(0), lines(5, 5){
     for (auto& row : board)
         for (auto& cell : row)
             cell = blank_symbol;
+    lines.add_all_runs(3);
 }
 
 bool X_O_5x5_Board::update_board(Move<char> *move) {
@@ -21,11 +22,15 @@ bool X_O_5x5_Board::update_board(Move<char> *move) {
 
         if (sym == 0) { // Undo move
             n_moves--;
+            int side = BitBoard::xo_side(board[x][y]);
+            if (side >= 0) lines.remove(x, y, side);
             board[x][y] = blank_symbol;
         }
         else {         // Apply move
             n_moves++;
             board[x][y] = toupper(sym);
+            int side = BitBoard::xo_side(board[x][y]);
+            if (side >= 0) lines.place(x, y, side);
         }
         counter++;
 
@@ -34,87 +39,13 @@ bool X_O_5x5_Board::update_board(Move<char> *move) {
     return false;
 }
 
-bool X_O_5x5_Board::is_win(Player<char>* player) {
+bool X_O_5x5_Board::is_win(char symbol) {
     if (n_moves != 24) return false;
-    const char sym = (*player).get_symbol();
-    const char opponent = (player->get_symbol() == 'X') ? 'O' : 'X';
-    int cnt = 0,cnt2 = 0;
-    auto all_equal = [&](char a, char b, char c) {
-        return a == b && b == c && a == sym;
-    };
-
-    // Rows
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < columns - 2; j++) {
-            if (all_equal(board[i][j], board[i][j+1], board[i][j+2]))
-                cnt++;
-        }
-    }
-
-    // Columns
-    for (int j = 0; j < columns; j++) {
-        for (int i = 0; i < rows - 2; i++) {
-            if (all_equal(board[i][j], board[i+1][j], board[i+2][j]))
-                cnt++;
-        }
-    }
-
-    // Diagonal
-    for (int i = 0; i < rows - 2; i++) {
-        for (int j = 0; j < columns - 2; j++) {
-            if (all_equal(board[i][j], board[i+1][j+1], board[i+2][j+2]))
-                cnt++;
-        }
-    }
-
-    // Diagonal
-    for (int i = 0; i < rows - 2; i++) {
-        for (int j = 2; j < columns; j++) {
-            if (all_equal(board[i][j], board[i+1][j-1], board[i+2][j-2]))
-                cnt++;
-        }
-    }
-
-    // for opponent --------------------------------------------
-    auto all_equal2 = [&](char a, char b, char c) {
-        return a == b && b == c && a == opponent;
-    };
-
-    // Rows
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < columns - 2; j++) {
-            if (all_equal2(board[i][j], board[i][j+1], board[i][j+2]))
-                cnt2++;
-        }
-    }
-
-    // Columns
-    for (int j = 0; j < columns; j++) {
-        for (int i = 0; i < rows - 2; i++) {
-            if (all_equal2(board[i][j], board[i+1][j], board[i+2][j]))
-                cnt2++;
-        }
-    }
-
-    // Diagonal
-    for (int i = 0; i < rows - 2; i++) {
-        for (int j = 0; j < columns - 2; j++) {
-            if (all_equal2(board[i][j], board[i+1][j+1], board[i+2][j+2]))
-                cnt2++;
-        }
-    }
+    int me = BitBoard::xo_side(symbol);
+    if (me < 0) return false;
 
-    // Diagonal
-    for (int i = 0; i < rows - 2; i++) {
-        for (int j = 2; j < columns; j++) {
-            if (all_equal2(board[i][j], board[i+1][j-1], board[i+2][j-2]))
-                cnt2++;
-        }
-    }
-    ///---------------------------------------------------------------
-
-    if (cnt > cnt2) return 1;
-    else return 0;
+    // More three-in-a-rows than the opponent
+    return lines.complete_lines(me) > lines.complete_lines(1 - me);
 }
 
 bool X_O_5x5_Board::is_lose(Player<char>* player) {
@@ -129,6 +60,33 @@ bool X_O_5x5_Board::game_is_over(Player<char>* player) {
     return is_win(player) || is_draw(player);
 }
 
+// Everything a position needs; the line counts are rebuilt from the cells
+struct X_O_5x5_State {
+    static constexpr uint32_t TAG = BoardSnapshot::make_tag("X5X5");
+    char cells[5][5];
+    int n_moves;
+    int counter;
+};
+
+bool X_O_5x5_Board::snapshot(BoardSnapshot& s) const {
+    X_O_5x5_State st;
+    save_cells(&st.cells[0][0]);
+    st.n_moves = n_moves;
+    st.counter = counter;
+    s.store(st);
+    return true;
+}
+
+bool X_O_5x5_Board::restore(const BoardSnapshot& s) {
+    X_O_5x5_State st;
+    if (!s.load(st)) return false;
+    load_cells(&st.cells[0][0]);
+    n_moves = st.n_moves;
+    counter = st.counter;
+    lines.rebuild(board, BitBoard::xo_side);
+    return true;
+}
+
 X_O_5x5_UI::X_O_5x5_UI() : UI<char>("Weclome to FCAI X-O 5X5 Game by Hazem", 3) {}
 
 Player<char>* X_O_5x5_UI::create_player(string& name, char symbol, PlayerType type) {
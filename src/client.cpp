@@ -0,0 +1,257 @@
+/**
+ * @file client.cpp
+ * @brief Test client of the game server (bgf_client).
+ *
+ * Without --sessions the client is a terminal for the protocol: lines typed on
+ * stdin are sent to the server and every line it sends is printed.
+ *
+ * With --sessions N it starts N games of one kind on a single connection and
+ * plays the human sides itself with random moves (an illegal move is simply
+ * replaced by another), then prints the results, the moves played and the
+ * moves per second over all games.
+ *
+ * Usage:
+ *   bgf_client [--socket PATH | --port N]
+ *   bgf_client [--socket PATH | --port N] --sessions N [--game G]
+ *              [--x human|ai] [--o human|ai] [--ms MS]
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+/**
+ * @brief Line-based connection to the server.
+ */
+class ServerConnection {
+private:
+    int fd = -1;
+    string buffer;
+
+public:
+    /** @brief Connect to a Unix socket path, or to 127.0.0.1:port if port >= 0. */
+    bool open(const string& path, int port) {
+        if (port >= 0) {
+            fd = socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(static_cast<uint16_t>(port));
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            return connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+        }
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) return false;
+        strcpy(addr.sun_path, path.c_str());
+        return connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    }
+
+    ~ServerConnection() {
+        if (fd >= 0) close(fd);
+    }
+
+    int get_fd() const { return fd; }
+
+    bool send_line(const string& line) {
+        string data = line + "\n";
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            sent += n;
+        }
+        return true;
+    }
+
+    /** @brief Read what is available (blocks until some data arrives); false once the server closed. */
+    bool receive() {
+        char data[65536];
+        ssize_t n;
+        do {
+            n = recv(fd, data, sizeof(data), 0);
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) return false;
+        buffer.append(data, n);
+        return true;
+    }
+
+    /** @brief Next complete line received, false if there is none yet. */
+    bool next_line(string& line) {
+        size_t end = buffer.find('\n');
+        if (end == string::npos) return false;
+        line = buffer.substr(0, end);
+        buffer.erase(0, end + 1);
+        return true;
+    }
+};
+
+static int interactive(ServerConnection& server) {
+    pollfd fds[2] = {{0, POLLIN, 0}, {server.get_fd(), POLLIN, 0}};
+    while (true) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            return 1;
+        }
+        if (fds[0].revents & (POLLIN | POLLHUP)) {
+            string line;
+            if (getline(cin, line)) {
+                if (!server.send_line(line)) return 1;
+            } else {
+                // Nothing more to send: wait for the server to answer and close
+                fds[0].fd = -1;
+                shutdown(server.get_fd(), SHUT_WR);
+            }
+        }
+        if (fds[1].revents & (POLLIN | POLLHUP)) {
+            if (!server.receive()) return 0;
+            string line;
+            while (server.next_line(line)) printf("%s\n", line.c_str());
+            fflush(stdout);
+        }
+    }
+}
+
+/**
+ * @brief A game started by the load test.
+ */
+struct ClientGame {
+    int rows = 0, columns = 0;
+    string format;
+    char symbol = 'X';    ///< Side of the human to move.
+    long long errors = 0; ///< Illegal random moves in a row.
+};
+
+/** @brief Random move text for MOVE (cell, then the value the game's format needs). */
+static string random_move(const ClientGame& g, mt19937& rng) {
+    auto pick = [&](int n) { return static_cast<int>(rng() % n); };
+    string move = to_string(pick(g.rows)) + " " + to_string(pick(g.columns));
+    if (g.format == "NUMBER") move += " " + to_string(g.symbol == 'X' ? 1 + 2 * pick(5) : 2 + 2 * pick(4));
+    else if (g.format == "LETTER") move += string(" ") + static_cast<char>('A' + pick(26));
+    else if (g.format == "SUS") move += pick(2) ? " S" : " U";
+    else if (g.format == "SLIDE") {
+        static const int dirs[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+        auto& d = dirs[pick(4)];
+        move += " " + to_string(d[0]) + " " + to_string(d[1]);
+    }
+    return move;
+}
+
+static int load_test(ServerConnection& server, int sessions, int game, const string& x, const string& o, int ms) {
+    const long long MAX_ERRORS = 10000;
+    mt19937 rng(random_device{}());
+    unordered_map<long long, ClientGame> games;
+    unordered_map<string, int> results;
+    long long moves = 0, started = 0, finished = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < sessions; i++) {
+        string line = "NEW " + to_string(game) + " " + x + " " + o;
+        if (ms >= 0) line += " " + to_string(ms);
+        if (!server.send_line(line)) return 1;
+    }
+
+    while (finished < sessions) {
+        if (!server.receive()) {
+            fprintf(stderr, "server closed the connection\n");
+            return 1;
+        }
+        string line;
+        while (server.next_line(line)) {
+            istringstream in(line);
+            string event;
+            long long id = 0;
+            in >> event >> id;
+            if (event == "SESSION") {
+                ClientGame& g = games[id];
+                in >> g.rows >> g.columns >> g.format;
+                started++;
+            } else if (event == "TURN" || (event == "ERR" && games.count(id))) {
+                ClientGame& g = games[id];
+                if (event == "TURN") {
+                    in >> g.symbol;
+                    g.errors = 0;
+                } else if (++g.errors >= MAX_ERRORS) {
+                    // No legal random move found: give up on the game
+                    server.send_line("CLOSE " + to_string(id));
+                    games.erase(id);
+                    results["STUCK"]++;
+                    finished++;
+                    continue;
+                }
+                server.send_line("MOVE " + to_string(id) + " " + random_move(g, rng));
+            } else if (event == "MOVED") {
+                moves++;
+            } else if (event == "OVER") {
+                string result;
+                in >> result;
+                results[result]++;
+                finished++;
+                games.erase(id);
+                server.send_line("CLOSE " + to_string(id));
+            } else if (event == "ERR") {
+                fprintf(stderr, "%s\n", line.c_str());
+                if (started == 0) return 1;
+            }
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    server.send_line("QUIT");
+
+    printf("sessions    %d of game %d (%s vs %s)\n", sessions, game, x.c_str(), o.c_str());
+    printf("results     X %d / O %d / D %d, unfinished %d, stuck %d\n", results["X"], results["O"],
+           results["DRAW"], results["UNFINISHED"], results["STUCK"]);
+    printf("moves       %lld in %.2f s (%.0f moves/s)\n", moves, seconds, moves / seconds);
+    return 0;
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: bgf_client [--socket PATH | --port N]\n"
+            "       bgf_client [--socket PATH | --port N] --sessions N [--game G]\n"
+            "                  [--x human|ai] [--o human|ai] [--ms MS]\n");
+}
+
+int main(int argc, char** argv) {
+    string path = "bgf.sock";
+    int port = -1, sessions = 0, game = 1, ms = -1;
+    string x = "human", o = "ai";
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) { usage(); return 1; }
+        string value = argv[++i];
+        if (arg == "--socket") path = value;
+        else if (arg == "--port") port = stoi(value);
+        else if (arg == "--sessions") sessions = stoi(value);
+        else if (arg == "--game") game = stoi(value);
+        else if (arg == "--x") x = value;
+        else if (arg == "--o") o = value;
+        else if (arg == "--ms") ms = stoi(value);
+        else { usage(); return 1; }
+    }
+
+    ServerConnection server;
+    if (!server.open(path, port)) {
+        if (port >= 0) fprintf(stderr, "cannot connect to 127.0.0.1:%d\n", port);
+        else fprintf(stderr, "cannot connect to %s\n", path.c_str());
+        return 1;
+    }
+    return sessions > 0 ? load_test(server, sessions, game, x, o, ms) : interactive(server);
+}
@@ -0,0 +1,36 @@
+/**
+ * @file dictc.cpp
+ * @brief Word list compiler (bgf_dictc).
+ *
+ * Reads a word list (one word per line) and writes the trie in the compiled
+ * format of WordDictionary, which the games map read-only instead of parsing
+ * the list. The build runs it on dic.txt to produce dic.bin.
+ *
+ * Usage:
+ *   bgf_dictc <words.txt> <out.bin>
+ */
+
+#include <cstdio>
+
+#include "../include/Word_Dictionary.h"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: bgf_dictc <words.txt> <out.bin>\n");
+        return 1;
+    }
+
+    WordDictionary dictionary;
+    if (!dictionary.load(argv[1])) {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+    if (!dictionary.save_compiled(argv[2])) {
+        fprintf(stderr, "cannot write %s\n", argv[2]);
+        return 1;
+    }
+    printf("%zu words, letters %s -> %s\n", dictionary.size(), dictionary.letters().c_str(), argv[2]);
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file records.cpp
+ * @brief Game record reader (bgf_records).
+ *
+ * Streams a file written by bgf_selfplay --record (or by the menu with
+ * $BGF_RECORD set) one record at a time and prints per game: the number of
+ * records, X wins / O wins / draws / unfinished games and moves per game.
+ * With --replay every record is also played again on a new board of its game,
+ * and records whose moves the board rejects are counted.
+ *
+ * Usage:
+ *   bgf_records <file> [--replay] [--print N]
+ *
+ * --print N writes the moves of the first N records.
+ */
+
+#include <iostream>
+#include <string>
+#include <map>
+#include <cstdio>
+
+#include "../include/BoardGame_Classes.h"
+#include "../include/Four_Four_XO.h"
+#include "../include/Infinity_XO_Classes.h"
+#include "../include/Numerical_X_O.h"
+#include "../include/Misere_Tic_Tac_Toe.h"
+#include "../include/SUS_Classes.h"
+#include "../include/X_O_5x5.h"
+#include "../include/Pyramid_XO.h"
+#include "../include/Four-in-a-row.h"
+#include "../include/Diamond_Tic_Tac_Toe.h"
+#include "../include/Obstacles_XO.h"
+#include "../include/Words_XO.h"
+#include "../include/Memory_Tic-Tac-Toe.h"
+#include "../include/Ultimate_Tic_Tac_Toe.h"
+#include "../include/Game_Record.h"
+
+#include "include/gamesMenu.h"
+
+using namespace std;
+
+/**
+ * @brief Totals over the records of one game.
+ */
+struct RecordStats {
+    long long records = 0, moves = 0, rejected = 0;
+    long long results[4] = {0, 0, 0, 0}; ///< Indexed by GameRecord::Result.
+};
+
+static void usage() {
+    fprintf(stderr, "usage: bgf_records <file> [--replay] [--print N]\n");
+}
+
+static void print_record(const GameRecord& r) {
+    static const char* results[] = {"X wins", "O wins", "draw", "unfinished"};
+    printf("game %u  %s (X) vs %s (O)  %s:", r.game_id, r.players[0].c_str(), r.players[1].c_str(),
+           r.result < 4 ? results[r.result] : "?");
+    for (size_t i = 0; i < r.moves.size(); i++) {
+        const RecordedMove& m = r.moves[i];
+        printf(" %d%d", m.x, m.y);
+        if (r.move_type == RecordedMoveType::SLIDE) printf("%+d%+d", m.dx, m.dy);
+        else if (r.move_type != RecordedMoveType::PLAIN) printf("=%c", m.value);
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) { usage(); return 1; }
+    string path = argv[1];
+    bool replay = false;
+    long long print = 0;
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--replay") replay = true;
+        else if (arg == "--print" && i + 1 < argc) print = stoll(argv[++i]);
+        else { usage(); return 1; }
+    }
+
+    GameRecordReader reader(path);
+    if (!reader.is_open()) {
+        fprintf(stderr, "cannot read %s\n", path.c_str());
+        return 1;
+    }
+
+    // Boards and UIs print to cout; silence it while replaying
+    streambuf* console = cout.rdbuf(nullptr);
+    Menu menu;
+
+    map<uint32_t, RecordStats> stats;
+    GameRecord record;
+    long long read = 0;
+    while (reader.next(record)) {
+        if (read++ < print) print_record(record);
+        RecordStats& s = stats[record.game_id];
+        s.records++;
+        s.moves += record.moves.size();
+        if (record.result < 4) s.results[record.result]++;
+        if (replay) {
+            auto it = menu.get_options().find(static_cast<int>(record.game_id));
+            if (it == menu.get_options().end() || !it->second->replay(record)) s.rejected++;
+        }
+    }
+    cout.rdbuf(console);
+    cout.clear();
+
+    for (auto& item : stats) {
+        auto it = menu.get_options().find(static_cast<int>(item.first));
+        const RecordStats& s = item.second;
+        printf("%2u %-22s %9lld records  X %lld / O %lld / D %lld, unfinished %lld  %.2f moves/game",
+               item.first, it != menu.get_options().end() ? it->second->get_name().c_str() : "?",
+               s.records, s.results[0], s.results[1], s.results[2], s.results[3],
+               double(s.moves) / s.records);
+        if (replay) printf("  rejected %lld", s.rejected);
+        printf("\n");
+    }
+    return 0;
+}
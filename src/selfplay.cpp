@@ -0,0 +1,213 @@
+/**
+ * @file selfplay.cpp
+ * @brief Headless self-play runner (bgf_selfplay).
+ *
+ * Plays N games of one registered game between two computer players, A and B,
+ * without console input or board output. Games run on a pool of threads and
+ * the players swap sides every game (A is X in even games). At the end a summary
+ * is printed: A's wins / draws / losses, unfinished games, moves per game and
+ * the average thinking time per move of each player.
+ *
+ * Usage:
+ *   bgf_selfplay --game <number|name> [--games N] [--threads N]
+ *                [--a-ms MS] [--b-ms MS] [--a-depth D] [--b-depth D]
+ *                [--a-search-threads N] [--b-search-threads N]
+ *                [--a-playouts N] [--b-playouts N]
+ *                [--max-moves N] [--max-retries N] [--record FILE] [--stats FILE]
+ *
+ * With --record every game is appended to FILE (see GameRecordWriter), with
+ * the players named "A" and "B". With --stats every computer move appends one
+ * JSON line to FILE: nodes, evaluations, cutoffs, table hits, depth and time
+ * of its search (see SearchStats).
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+#include "../include/BoardGame_Classes.h"
+#include "../include/Four_Four_XO.h"
+#include "../include/Infinity_XO_Classes.h"
+#include "../include/Numerical_X_O.h"
+#include "../include/Misere_Tic_Tac_Toe.h"
+#include "../include/SUS_Classes.h"
+#include "../include/X_O_5x5.h"
+#include "../include/Pyramid_XO.h"
+#include "../include/Four-in-a-row.h"
+#include "../include/Diamond_Tic_Tac_Toe.h"
+#include "../include/Obstacles_XO.h"
+#include "../include/Words_XO.h"
+#include "../include/Memory_Tic-Tac-Toe.h"
+#include "../include/Ultimate_Tic_Tac_Toe.h"
+
+#include "include/gamesMenu.h"
+
+using namespace std;
+
+/**
+ * @brief Stream buffer that drops everything written to it.
+ *
+ * It has no put area, so concurrent writers never touch shared buffer state.
+ */
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+/**
+ * @brief Totals over all games, from player A's point of view.
+ */
+struct SelfPlayStats {
+    int wins = 0, draws = 0, losses = 0, unfinished = 0;
+    long long moves = 0;
+    long long moves_by[2] = {0, 0};  ///< Moves of A and B.
+    double think_ms[2] = {0.0, 0.0}; ///< Thinking time of A and B.
+
+    void add(const GameOutcome& o, int a_index) {
+        int b_index = 1 - a_index;
+        if (!o.finished) unfinished++;
+        else if (o.winner == a_index) wins++;
+        else if (o.winner == b_index) losses++;
+        else draws++;
+        moves += o.moves;
+        moves_by[0] += o.moves_by[a_index];
+        moves_by[1] += o.moves_by[b_index];
+        think_ms[0] += o.think_ms[a_index];
+        think_ms[1] += o.think_ms[b_index];
+    }
+};
+
+static void usage() {
+    fprintf(stderr,
+            "usage: bgf_selfplay --game <number|name> [--games N] [--threads N]\n"
+            "                    [--a-ms MS] [--b-ms MS] [--a-depth D] [--b-depth D]\n"
+            "                    [--a-search-threads N] [--b-search-threads N]\n"
+            "                    [--a-playouts N] [--b-playouts N]\n"
+            "                    [--max-moves N] [--max-retries N] [--record FILE] [--stats FILE]\n");
+}
+
+int main(int argc, char** argv) {
+    string game, record, stats_path;
+    int games = 100, threads = 0, max_moves = 1000, max_retries = 100;
+    PlayerSettings a, b;
+    // Searches default to a single thread, the pool already keeps the cores busy
+    a.search_threads = b.search_threads = 1;
+    a.name = "A";
+    b.name = "B";
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) { usage(); return 1; }
+        string value = argv[++i];
+        if (arg == "--game") game = value;
+        else if (arg == "--games") games = stoi(value);
+        else if (arg == "--threads") threads = stoi(value);
+        else if (arg == "--a-ms") a.time_budget_ms = stoi(value);
+        else if (arg == "--b-ms") b.time_budget_ms = stoi(value);
+        else if (arg == "--a-depth") a.max_depth = stoi(value);
+        else if (arg == "--b-depth") b.max_depth = stoi(value);
+        else if (arg == "--a-search-threads") a.search_threads = stoi(value);
+        else if (arg == "--b-search-threads") b.search_threads = stoi(value);
+        else if (arg == "--a-playouts") a.playouts = stoi(value);
+        else if (arg == "--b-playouts") b.playouts = stoi(value);
+        else if (arg == "--max-moves") max_moves = stoi(value);
+        else if (arg == "--max-retries") max_retries = stoi(value);
+        else if (arg == "--record") record = value;
+        else if (arg == "--stats") stats_path = value;
+        else { usage(); return 1; }
+    }
+
+    srand(static_cast<unsigned int>(time(0)));
+
+    // Games and UIs print to cout; silence it for the whole run
+    NullBuffer null_buffer;
+    streambuf* console = cout.rdbuf(&null_buffer);
+
+    Menu menu;
+    GameLauncher* launcher = nullptr;
+    int game_id = 0;
+    for (auto& option : menu.get_options())
+        if (to_string(option.first) == game || option.second->get_name() == game) {
+            launcher = option.second;
+            game_id = option.first;
+        }
+
+    if (!launcher) {
+        cout.rdbuf(console);
+        fprintf(stderr, "Unknown game '%s'. Registered games:\n", game.c_str());
+        for (auto& option : menu.get_options())
+            fprintf(stderr, "  %d. %s\n", option.first, option.second->get_name().c_str());
+        return 1;
+    }
+
+    unique_ptr<GameRecordWriter> records;
+    if (!record.empty()) {
+        records.reset(new GameRecordWriter(record));
+        if (!records->is_open()) {
+            cout.rdbuf(console);
+            fprintf(stderr, "cannot open %s\n", record.c_str());
+            return 1;
+        }
+        launcher->set_recording(records.get(), game_id);
+    }
+
+    unique_ptr<SearchStatsFile> search_stats;
+    if (!stats_path.empty()) {
+        search_stats.reset(new SearchStatsFile(stats_path));
+        if (!search_stats->is_open()) {
+            cout.rdbuf(console);
+            fprintf(stderr, "cannot open %s\n", stats_path.c_str());
+            return 1;
+        }
+        launcher->set_stats(search_stats.get());
+    }
+
+    threads = resolve_search_threads(threads);
+    if (!launcher->parallel_safe()) threads = 1;
+    if (threads > games) threads = max(games, 1);
+
+    SelfPlayStats stats;
+    mutex stats_lock;
+    atomic<int> next{0};
+
+    auto start = chrono::steady_clock::now();
+    auto worker = [&]() {
+        for (int g = next.fetch_add(1); g < games; g = next.fetch_add(1)) {
+            int a_index = g % 2; // A plays X in even games
+            PlayerSettings settings[2];
+            settings[a_index] = a;
+            settings[1 - a_index] = b;
+
+            GameOutcome outcome = launcher->play_headless(settings, max_moves, max_retries);
+            lock_guard<mutex> guard(stats_lock);
+            stats.add(outcome, a_index);
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout.rdbuf(console);
+
+    printf("game        %s\n", launcher->get_name().c_str());
+    printf("games       %d on %d thread(s) in %.2f s\n", games, threads, elapsed);
+    printf("A results   W %d / D %d / L %d, unfinished %d\n",
+           stats.wins, stats.draws, stats.losses, stats.unfinished);
+    printf("moves/game  %.2f\n", games ? double(stats.moves) / games : 0.0);
+    printf("ms/move     A %.3f, B %.3f\n",
+           stats.moves_by[0] ? stats.think_ms[0] / stats.moves_by[0] : 0.0,
+           stats.moves_by[1] ? stats.think_ms[1] / stats.moves_by[1] : 0.0);
+
+    return 0;
+}
@@ -0,0 +1,677 @@
+/**
+ * @file server.cpp
+ * @brief Multi-session game server (bgf_server).
+ *
+ * Hosts any number of games of the menu in one process. Clients connect over
+ * a Unix domain socket (or loopback TCP) and speak a line protocol; one
+ * connection may run many games at once. A single thread owns the sockets and
+ * the boards and never searches: computer moves are computed on a pool of
+ * worker threads and applied when they are ready, so a slow search only delays
+ * its own game.
+ *
+ * Usage:
+ *   bgf_server [--socket PATH | --port N] [--workers N] [--max-moves N] [--max-retries N]
+ *              [--ponder on|off] [--stats FILE]
+ *
+ * The default socket is bgf.sock in the current directory; --port listens on
+ * 127.0.0.1 instead. --workers defaults to one thread per hardware thread.
+ * With --ponder on, a computer playing a human keeps searching the human's
+ * possible replies on a thread of its own (outside the pool) after each of
+ * its moves, and usually answers at once. --stats appends one JSON line per
+ * computer move to FILE with the statistics of its search (see SearchStats).
+ *
+ * Protocol, one command or event per line, fields separated by spaces:
+ *
+ *   GAMES                       -> GAME <n> <name> for every game, then END
+ *   NEW <n> <x> <o> [ms]        start game n; x and o are "human" or "ai",
+ *                               ms the search time per computer move
+ *                               -> SESSION <id> <rows> <columns> <format>
+ *   MOVE <id> <x> <y> [value]   play for the human to move; value is the number
+ *                               or letter (formats NUMBER, LETTER, SUS) or
+ *                               "dx dy" (SLIDE)
+ *   BOARD <id>                  -> BOARD <id> <rows of cells separated by '/'>
+ *   CLOSE <id>                  -> CLOSED <id>
+ *   QUIT                        close the connection
+ *
+ * Events sent as the games progress:
+ *
+ *   TURN <id> <symbol>              a human player is to move
+ *   MOVED <id> <symbol> <x> <y> [value]   a move was played, by either side
+ *   OVER <id> X|O|DRAW|UNFINISHED
+ *   ERR [<id>] <reason>             a command was refused (an illegal move can
+ *                                   simply be sent again)
+ *
+ * <format> is PLAIN, NUMBER, LETTER, SUS or SLIDE (see RecordedMoveType).
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../include/BoardGame_Classes.h"
+#include "../include/Four_Four_XO.h"
+#include "../include/Infinity_XO_Classes.h"
+#include "../include/Numerical_X_O.h"
+#include "../include/Misere_Tic_Tac_Toe.h"
+#include "../include/SUS_Classes.h"
+#include "../include/X_O_5x5.h"
+#include "../include/Pyramid_XO.h"
+#include "../include/Four-in-a-row.h"
+#include "../include/Diamond_Tic_Tac_Toe.h"
+#include "../include/Obstacles_XO.h"
+#include "../include/Words_XO.h"
+#include "../include/Memory_Tic-Tac-Toe.h"
+#include "../include/Ultimate_Tic_Tac_Toe.h"
+#include "../include/Parallel_Search.h"
+
+#include "include/gamesMenu.h"
+
+using namespace std;
+
+static volatile sig_atomic_t stopping = 0;
+
+static void on_signal(int) { stopping = 1; }
+
+/**
+ * @brief Stream buffer that drops everything written to it (boards and UIs print to cout).
+ */
+class NullBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+static const char* format_name(RecordedMoveType type) {
+    switch (type) {
+        case RecordedMoveType::NUMBER: return "NUMBER";
+        case RecordedMoveType::LETTER: return "LETTER";
+        case RecordedMoveType::SUS:    return "SUS";
+        case RecordedMoveType::SLIDE:  return "SLIDE";
+        default:                       return "PLAIN";
+    }
+}
+
+/** @brief "x y" followed by the payload of the move's format, as in MOVE and MOVED. */
+static string move_text(const RecordedMove& m, RecordedMoveType type) {
+    string text = to_string(m.x) + " " + to_string(m.y);
+    if (type == RecordedMoveType::SLIDE) text += " " + to_string(m.dx) + " " + to_string(m.dy);
+    else if (type != RecordedMoveType::PLAIN) text += string(" ") + m.value;
+    return text;
+}
+
+/** @brief Read the fields of move_text(); false if some are missing or out of range. */
+static bool parse_move(istringstream& in, RecordedMoveType type, RecordedMove& m) {
+    int x, y;
+    if (!(in >> x >> y) || x < 0 || y < 0 || x > 255 || y > 255) return false;
+    m.x = static_cast<uint8_t>(x);
+    m.y = static_cast<uint8_t>(y);
+    if (type == RecordedMoveType::SLIDE) {
+        int dx, dy;
+        if (!(in >> dx >> dy) || dx < -1 || dx > 1 || dy < -1 || dy > 1) return false;
+        m.dx = static_cast<int8_t>(dx);
+        m.dy = static_cast<int8_t>(dy);
+    } else if (type != RecordedMoveType::PLAIN) {
+        if (!(in >> m.value)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Fixed set of threads running submitted jobs in order.
+ */
+class WorkerPool {
+private:
+    mutex lock;
+    condition_variable ready;
+    deque<function<void()>> jobs;
+    vector<thread> threads;
+    bool stop = false;
+
+    void work() {
+        while (true) {
+            function<void()> job;
+            {
+                unique_lock<mutex> guard(lock);
+                ready.wait(guard, [&] { return stop || !jobs.empty(); });
+                if (jobs.empty()) return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+public:
+    explicit WorkerPool(int count) {
+        for (int i = 0; i < count; i++) threads.emplace_back([this] { work(); });
+    }
+
+    /** @brief Drop the jobs not started yet, wait for the running ones. */
+    ~WorkerPool() {
+        {
+            lock_guard<mutex> guard(lock);
+            stop = true;
+            jobs.clear();
+        }
+        ready.notify_all();
+        for (auto& t : threads) t.join();
+    }
+
+    void submit(function<void()> job) {
+        {
+            lock_guard<mutex> guard(lock);
+            jobs.push_back(std::move(job));
+        }
+        ready.notify_one();
+    }
+};
+
+/**
+ * @brief One game hosted by the server, driven through its GameManager.
+ *
+ * Only the socket thread touches a session, except for the worker computing
+ * its move while it is thinking; no move is submitted in that time.
+ */
+struct Session {
+    uint64_t id = 0;
+    int connection = -1;             ///< Socket of the client that started the game.
+    unique_ptr<GameSession> game;
+    unique_ptr<GameManager<char>> manager;
+    mutex* serial = nullptr;         ///< Held by searches of games that are not parallel_safe().
+    bool thinking = false;           ///< A worker is computing the pending player's move.
+    int rejected = 0;                ///< Computer moves in a row rejected by the board.
+    bool closed = false;             ///< Dropped while THINKING: deleted when the search returns.
+    vector<vector<char>> shown;      ///< Board after the last move (searches may play on the real one).
+
+    ~Session() {
+        // Ends the players' pondering before they are deleted
+        if (manager) manager->stop();
+    }
+};
+
+/**
+ * @brief Socket loop, sessions and worker pool.
+ */
+class GameServer {
+private:
+    /** @brief A connected client, with the bytes not yet parsed or sent. */
+    struct Connection {
+        string in, out;
+        set<uint64_t> sessions;
+        bool quitting = false;
+    };
+
+    /** @brief Move computed by a worker (nullptr if the player had none). */
+    struct Result {
+        uint64_t session;
+        Move<char>* move;
+    };
+
+    Menu menu;
+    unique_ptr<WorkerPool> pool;     ///< Stopped first: its jobs use the sessions.
+    int listener;
+    int wake[2];                     ///< Workers write a byte to wake[1] when a result is queued.
+    int max_moves, max_retries;
+    bool ponder;                     ///< Computers search on their human opponent's time.
+    map<int, Connection> connections;
+    unordered_map<uint64_t, unique_ptr<Session>> sessions;
+    map<int, mutex> serial;          ///< Per game number, for games that are not parallel_safe().
+    uint64_t next_id = 1;
+
+    mutex results_lock;
+    vector<Result> results;
+
+    void send(int fd, const string& line) {
+        auto it = connections.find(fd);
+        if (it != connections.end()) it->second.out += line + "\n";
+    }
+
+    void flush(int fd, Connection& c) {
+        while (!c.out.empty()) {
+            ssize_t n = ::send(fd, c.out.data(), c.out.size(), MSG_NOSIGNAL);
+            if (n <= 0) return;
+            c.out.erase(0, n);
+        }
+    }
+
+    //------------------------------------------------------- Turns
+
+    void compute_move(Session* s) {
+        s->thinking = true;
+        pool->submit([this, s] {
+            Move<char>* move = nullptr;
+            {
+                unique_lock<mutex> guard;
+                if (s->serial) guard = unique_lock<mutex>(*s->serial);
+                try {
+                    move = s->manager->compute_move();
+                } catch (const exception&) {
+                    move = nullptr;
+                }
+            }
+            {
+                lock_guard<mutex> guard(results_lock);
+                results.push_back({s->id, move});
+            }
+            char byte = 0;
+            (void)!write(wake[1], &byte, 1);
+        });
+    }
+
+    /** @brief Report the end of the game, or ask the pending player for a move. */
+    void next_turn(Session* s) {
+        const GameStatus& status = s->manager->poll_state();
+        if (status.over) {
+            const char* result = !status.finished ? "UNFINISHED" : status.winner < 0 ? "DRAW" :
+                                 status.winner == 0 ? "X" : "O";
+            send(s->connection, "OVER " + to_string(s->id) + " " + result);
+            return;
+        }
+        Player<char>* player = s->manager->pending_player();
+        if (player->get_type() == PlayerType::COMPUTER) compute_move(s);
+        else send(s->connection, "TURN " + to_string(s->id) + " " + player->get_symbol());
+    }
+
+    /** @brief Stop the game as unfinished and report it. */
+    void stop(Session* s) {
+        s->manager->stop();
+        next_turn(s);
+    }
+
+    /** @brief Submit a move of the pending player (deleted here); false if the board rejects it. */
+    bool play(Session* s, Move<char>* move) {
+        char symbol = s->manager->pending_player()->get_symbol();
+        if (s->manager->submit_move(move) != MoveResult::ACCEPTED) {
+            delete move;
+            return false;
+        }
+        RecordedMoveType type = s->game->move_type;
+        RecordedMove m = recorded_move(*move, type);
+        delete move;
+
+        send(s->connection, "MOVED " + to_string(s->id) + " " + symbol + " " + move_text(m, s->game->move_type));
+        s->shown = s->game->board->get_board_matrix();
+        s->rejected = 0;
+        if (s->manager->poll_state().moves >= max_moves) s->manager->stop();
+        next_turn(s);
+        return true;
+    }
+
+    void apply_results() {
+        char drain[256];
+        while (read(wake[0], drain, sizeof(drain)) > 0) {}
+
+        vector<Result> ready;
+        {
+            lock_guard<mutex> guard(results_lock);
+            ready.swap(results);
+        }
+        for (auto& r : ready) {
+            auto it = sessions.find(r.session);
+            if (it == sessions.end()) {
+                delete r.move;
+                continue;
+            }
+            Session* s = it->second.get();
+            if (s->closed) {
+                delete r.move;
+                sessions.erase(it);
+                continue;
+            }
+            s->thinking = false;
+            if (!r.move) stop(s);
+            else if (!play(s, r.move)) {
+                if (++s->rejected >= max_retries) stop(s);
+                else compute_move(s);
+            }
+        }
+    }
+
+    //------------------------------------------------------- Commands
+
+    /** @brief Session named by the command if it belongs to this connection, else nullptr (ERR sent). */
+    Session* find_session(int fd, istringstream& in) {
+        uint64_t id = 0;
+        in >> id;
+        auto it = sessions.find(id);
+        if (it == sessions.end() || it->second->closed || it->second->connection != fd) {
+            send(fd, "ERR " + to_string(id) + " no such session");
+            return nullptr;
+        }
+        return it->second.get();
+    }
+
+    void close_session(Session* s) {
+        connections[s->connection].sessions.erase(s->id);
+        // A worker may still be searching on its board
+        if (s->thinking) s->closed = true;
+        else sessions.erase(s->id);
+    }
+
+    void new_game(int fd, istringstream& in) {
+        int number;
+        string kinds[2];
+        int ms = -1;
+        if (!(in >> number >> kinds[0] >> kinds[1])) {
+            send(fd, "ERR usage: NEW <game> <human|ai> <human|ai> [ms]");
+            return;
+        }
+        in >> ms;
+        auto option = menu.get_options().find(number);
+        if (option == menu.get_options().end()) {
+            send(fd, "ERR unknown game " + to_string(number));
+            return;
+        }
+
+        PlayerType types[2];
+        PlayerSettings settings[2];
+        for (int i = 0; i < 2; i++) {
+            if (kinds[i] != "human" && kinds[i] != "ai") {
+                send(fd, "ERR player type must be human or ai");
+                return;
+            }
+            types[i] = kinds[i] == "ai" ? PlayerType::COMPUTER : PlayerType::HUMAN;
+            settings[i].time_budget_ms = ms;
+            settings[i].search_threads = 1; // the pool already runs one search per worker
+        }
+        for (int i = 0; i < 2; i++)
+            settings[i].ponder = ponder && types[1 - i] == PlayerType::HUMAN;
+
+        auto s = make_unique<Session>();
+        s->id = next_id++;
+        s->connection = fd;
+        s->game = option->second->new_session(types, settings);
+        if (!option->second->parallel_safe()) s->serial = &serial[number];
+        Player<char>* players[2] = {s->game->players[0].get(), s->game->players[1].get()};
+        s->manager.reset(new GameManager<char>(s->game->board.get(), players, s->game->ui.get()));
+        s->manager->start();
+        s->shown = s->game->board->get_board_matrix();
+
+        Session* session = s.get();
+        sessions[session->id] = std::move(s);
+        connections[fd].sessions.insert(session->id);
+        send(fd, "SESSION " + to_string(session->id) + " " + to_string(session->game->board->get_rows()) + " " +
+                 to_string(session->game->board->get_columns()) + " " + format_name(session->game->move_type));
+        next_turn(session);
+    }
+
+    void human_move(int fd, istringstream& in) {
+        Session* s = find_session(fd, in);
+        if (!s) return;
+        string id = to_string(s->id);
+        if (s->manager->poll_state().over || s->thinking) {
+            send(fd, "ERR " + id + (s->thinking ? " not your turn" : " game over"));
+            return;
+        }
+        RecordedMove m;
+        if (!parse_move(in, s->game->move_type, m)) {
+            send(fd, string("ERR ") + id + " usage: MOVE <id> <x> <y>" +
+                     (s->game->move_type == RecordedMoveType::SLIDE ? " <dx> <dy>" :
+                      s->game->move_type == RecordedMoveType::PLAIN ? "" : " <value>"));
+            return;
+        }
+        char symbol = s->manager->pending_player()->get_symbol();
+        if (!play(s, GameRecord::make_move(s->game->move_type, m, symbol))) send(fd, "ERR " + id + " illegal move");
+    }
+
+    void show_board(int fd, istringstream& in) {
+        Session* s = find_session(fd, in);
+        if (!s) return;
+        string cells;
+        for (auto& row : s->shown) {
+            if (!cells.empty()) cells += '/';
+            cells.append(row.begin(), row.end());
+        }
+        send(fd, "BOARD " + to_string(s->id) + " " + cells);
+    }
+
+    void command(int fd, const string& line) {
+        istringstream in(line);
+        string cmd;
+        if (!(in >> cmd)) return;
+        if (cmd == "GAMES") {
+            for (auto& item : menu.get_options())
+                send(fd, "GAME " + to_string(item.first) + " " + item.second->get_name());
+            send(fd, "END");
+        } else if (cmd == "NEW") {
+            new_game(fd, in);
+        } else if (cmd == "MOVE") {
+            human_move(fd, in);
+        } else if (cmd == "BOARD") {
+            show_board(fd, in);
+        } else if (cmd == "CLOSE") {
+            if (Session* s = find_session(fd, in)) {
+                uint64_t id = s->id;
+                close_session(s);
+                send(fd, "CLOSED " + to_string(id));
+            }
+        } else if (cmd == "QUIT") {
+            connections[fd].quitting = true;
+        } else {
+            send(fd, "ERR unknown command " + cmd);
+        }
+    }
+
+    //------------------------------------------------------- Sockets
+
+    void disconnect(int fd) {
+        Connection& c = connections[fd];
+        for (uint64_t id : vector<uint64_t>(c.sessions.begin(), c.sessions.end()))
+            close_session(sessions[id].get());
+        connections.erase(fd);
+        close(fd);
+    }
+
+    void accept_clients() {
+        while (true) {
+            int fd = accept(listener, nullptr, nullptr);
+            if (fd < 0) return;
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            connections[fd];
+        }
+    }
+
+    /** @brief Read what the client sent and run its complete lines; false on a socket error. */
+    bool receive(int fd, Connection& c) {
+        char buffer[4096];
+        while (true) {
+            ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+            if (n == 0) {
+                // The client sent everything: answer it, then close
+                c.quitting = true;
+                break;
+            }
+            if (n < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                if (errno == EINTR) continue;
+                return false;
+            }
+            c.in.append(buffer, n);
+        }
+        size_t start = 0, end;
+        while ((end = c.in.find('\n', start)) != string::npos) {
+            string line = c.in.substr(start, end - start);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            start = end + 1;
+            command(fd, line);
+        }
+        c.in.erase(0, start);
+        return true;
+    }
+
+public:
+    GameServer(int listener, int workers, int max_moves, int max_retries, bool ponder)
+        : pool(new WorkerPool(workers)), listener(listener), max_moves(max_moves), max_retries(max_retries),
+          ponder(ponder) {
+        if (pipe(wake) != 0) throw runtime_error("cannot create wake pipe");
+        for (int fd : {listener, wake[0], wake[1]}) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    }
+
+    /** @brief Send the search statistics of the computer players of new sessions to sink. */
+    void set_stats(SearchStatsSink* sink) {
+        for (auto& item : menu.get_options()) item.second->set_stats(sink);
+    }
+
+    ~GameServer() {
+        pool.reset();
+        for (auto& c : connections) close(c.first);
+        close(wake[0]);
+        close(wake[1]);
+    }
+
+    /** @brief Serve clients until SIGINT or SIGTERM. */
+    void run() {
+        vector<pollfd> fds;
+        while (!stopping) {
+            fds.clear();
+            fds.push_back({listener, POLLIN, 0});
+            fds.push_back({wake[0], POLLIN, 0});
+            for (auto& c : connections) {
+                short events = (c.second.quitting ? 0 : POLLIN) | (c.second.out.empty() ? 0 : POLLOUT);
+                fds.push_back({c.first, events, 0});
+            }
+
+            if (poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) continue;
+                perror("poll");
+                return;
+            }
+
+            if (fds[1].revents & POLLIN) apply_results();
+            if (fds[0].revents & POLLIN) accept_clients();
+            for (size_t i = 2; i < fds.size(); i++) {
+                int fd = fds[i].fd;
+                auto it = connections.find(fd);
+                if (it == connections.end()) continue;
+                if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) && !receive(fd, it->second)) {
+                    disconnect(fd);
+                    continue;
+                }
+            }
+
+            // Send what the commands and results produced
+            vector<int> done;
+            for (auto& c : connections) {
+                flush(c.first, c.second);
+                if (c.second.quitting && c.second.out.empty()) done.push_back(c.first);
+            }
+            for (int fd : done) disconnect(fd);
+        }
+    }
+};
+
+static void usage() {
+    fprintf(stderr,
+            "usage: bgf_server [--socket PATH | --port N] [--workers N] [--max-moves N] [--max-retries N]\n"
+            "                  [--ponder on|off] [--stats FILE]\n");
+}
+
+int main(int argc, char** argv) {
+    string path = "bgf.sock";
+    int port = -1;
+    int workers = 0;
+    int max_moves = 1000, max_retries = 100;
+    bool ponder = false;
+    string stats_path;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) { usage(); return 1; }
+        string value = argv[++i];
+        if (arg == "--socket") path = value;
+        else if (arg == "--port") port = stoi(value);
+        else if (arg == "--workers") workers = stoi(value);
+        else if (arg == "--max-moves") max_moves = stoi(value);
+        else if (arg == "--max-retries") max_retries = stoi(value);
+        else if (arg == "--ponder" && (value == "on" || value == "off")) ponder = value == "on";
+        else if (arg == "--stats") stats_path = value;
+        else { usage(); return 1; }
+    }
+
+    int listener;
+    if (port >= 0) {
+        listener = socket(AF_INET, SOCK_STREAM, 0);
+        int on = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(port));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            perror("bind");
+            return 1;
+        }
+    } else {
+        listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) {
+            fprintf(stderr, "socket path too long: %s\n", path.c_str());
+            return 1;
+        }
+        strcpy(addr.sun_path, path.c_str());
+        unlink(path.c_str());
+        if (bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            perror("bind");
+            return 1;
+        }
+    }
+    if (listen(listener, SOMAXCONN) != 0) {
+        perror("listen");
+        return 1;
+    }
+
+    unique_ptr<SearchStatsFile> stats;
+    if (!stats_path.empty()) {
+        stats.reset(new SearchStatsFile(stats_path));
+        if (!stats->is_open()) {
+            fprintf(stderr, "cannot open %s\n", stats_path.c_str());
+            return 1;
+        }
+    }
+
+    srand(static_cast<unsigned int>(time(0)));
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    signal(SIGPIPE, SIG_IGN);
+
+    // Boards, UIs and players print to cout; the protocol is the only output
+    NullBuffer null_buffer;
+    streambuf* console = cout.rdbuf(&null_buffer);
+
+    workers = resolve_search_threads(workers);
+    if (port >= 0) fprintf(stderr, "bgf_server: 127.0.0.1:%d, %d workers\n", port, workers);
+    else fprintf(stderr, "bgf_server: %s, %d workers\n", path.c_str(), workers);
+    {
+        GameServer server(listener, workers, max_moves, max_retries, ponder);
+        server.set_stats(stats.get());
+        server.run();
+    }
+    cout.rdbuf(console);
+    close(listener);
+    if (port < 0) unlink(path.c_str());
+    return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file solve.cpp
+ * @brief Offline solver for the small X-O variants (bgf_solve).
+ *
+ * Walks every position reachable from the empty board with a memoised negamax,
+ * and writes one table per game with the value and best move of each position
+ * where a move is due, one entry per class of symmetric positions (see Tablebase). The table player of the game then plays
+ * perfectly by lookup, and the tables serve as ground truth for the heuristic
+ * engines.
+ *
+ * Usage:
+ *   bgf_solve [--game <name|all>] [--out DIR]
+ *
+ * Tables are written to DIR/<name>.tb (default DIR: tables).
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+
+#include "../include/Tablebase.h"
+
+using namespace std;
+
+/**
+ * @brief Memoised negamax over the positions of one game.
+ */
+class Solver {
+private:
+    const TablebaseRules& rules;
+    unordered_map<uint32_t, pair<int8_t, uint8_t>> solved; ///< key -> (score, best move)
+
+public:
+    explicit Solver(const TablebaseRules& rules) : rules(rules) {}
+
+    /**
+     * @brief Score of a position for the side to move (the game is not over).
+     *
+     * Symmetric positions share the value, only the canonical form is searched.
+     */
+    int solve(const TablebaseState& position) {
+        int t;
+        const TablebaseState s = rules.canonical(position, t);
+        uint32_t key = rules.key(s);
+        auto it = solved.find(key);
+        if (it != solved.end()) return it->second.first;
+
+        vector<int> moves;
+        rules.moves(s, moves);
+        int best = -1000, best_move = -1;
+        for (int move : moves) {
+            TablebaseState child = s;
+            rules.play(child, move);
+
+            int value;
+            switch (rules.result(child)) {
+                case TablebaseRules::MOVER_WINS:  value = 100; break;
+                case TablebaseRules::MOVER_LOSES: value = -100; break;
+                case TablebaseRules::DRAW:        value = 0; break;
+                default:
+                    // One ply further from the end: wins shrink, losses grow toward 0
+                    value = -solve(child);
+                    if (value > 0) value--;
+                    else if (value < 0) value++;
+            }
+            if (value > best) {
+                best = value;
+                best_move = move;
+            }
+        }
+        if (best_move < 0) best = 0; // no legal move (cannot happen in these games)
+
+        solved[key] = {static_cast<int8_t>(best), static_cast<uint8_t>(max(best_move, 0))};
+        return best;
+    }
+
+    /** @brief Solved positions as a table sorted by key. */
+    Tablebase table() const {
+        vector<uint32_t> keys;
+        keys.reserve(solved.size());
+        for (auto& entry : solved) keys.push_back(entry.first);
+        sort(keys.begin(), keys.end());
+
+        Tablebase t;
+        for (uint32_t key : keys) {
+            auto& entry = solved.at(key);
+            t.add(key, entry.first, entry.second);
+        }
+        return t;
+    }
+};
+
+static void usage() {
+    fprintf(stderr, "usage: bgf_solve [--game <name|all>] [--out DIR]\n");
+    fprintf(stderr, "games:");
+    for (auto& rules : tablebase_rules()) fprintf(stderr, " %s", rules->name().c_str());
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char** argv) {
+    string game = "all", out = "tables";
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) { usage(); return 1; }
+        string value = argv[++i];
+        if (arg == "--game") game = value;
+        else if (arg == "--out") out = value;
+        else { usage(); return 1; }
+    }
+
+    vector<shared_ptr<const TablebaseRules>> games;
+    if (game == "all") games = tablebase_rules();
+    else if (auto rules = find_tablebase_rules(game)) games.push_back(rules);
+    else { usage(); return 1; }
+
+    error_code ec;
+    filesystem::create_directories(out, ec);
+
+    for (auto& rules : games) {
+        auto start = chrono::steady_clock::now();
+
+        TablebaseState empty;
+        fill(begin(empty.cells), end(empty.cells), rules->blank());
+        Solver solver(*rules);
+        int root = solver.solve(empty);
+        Tablebase table = solver.table();
+
+        string path = out + "/" + rules->name() + ".tb";
+        if (!table.save(path)) {
+            fprintf(stderr, "cannot write %s\n", path.c_str());
+            return 1;
+        }
+
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        const char* verdict = root > 0 ? "first player wins" : (root < 0 ? "second player wins" : "draw");
+        printf("%-10s %9zu positions  root %4d (%s)  %.2f s  -> %s\n",
+               rules->name().c_str(), table.size(), root, verdict, elapsed, path.c_str());
+    }
+    return 0;
+}